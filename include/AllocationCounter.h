@@ -0,0 +1,15 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <cstddef>
+
+// Heap allocations made through operator new since the process started, and
+// the bytes they asked for, on any thread. Linking AllocationCounter.cpp
+// replaces the global operator new with one that adds two relaxed atomic
+// increments; take differences to count a span
+namespace AllocationCounter {
+    size_t total();
+    size_t bytes();
+}
+
+#endif
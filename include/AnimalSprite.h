@@ -11,12 +11,11 @@ private:
     static constexpr float GRAVITY = 200.0f;
     bool shouldDelete = false;
     GameMap* collisionMap = nullptr;
-    void initializeFrames() override;
     float lifetimeSeconds = 0.0f;
     static constexpr float MAX_LIFETIME = 5.0f;
 
 public:
-    explicit AnimalSprite(const sf::Vector2f& pos, bool moveRight = true);
+    AnimalSprite(const SpriteArchetypes& types, const sf::Vector2f& pos, bool moveRight = true);
     ~AnimalSprite() override = default;
 
     void update(float deltaTime) override;
@@ -0,0 +1,68 @@
+#ifndef ANIMATIONCLIP_H
+#define ANIMATIONCLIP_H
+
+#include <SFML/Graphics.hpp>
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// One frame of a clip: where it sits in the sheet, how long it stays on screen
+// and the hitbox relative to the frame's top-left corner
+struct AnimationFrame {
+    sf::IntRect rect;
+    float duration{0.1f};
+    sf::IntRect hitbox;
+};
+
+struct AnimationClip {
+    std::string name;
+    std::vector<AnimationFrame> frames;
+    int loopStart{0};   // frame to jump back to after the last one, -1 plays once and holds
+
+    bool loops() const { return loopStart >= 0; }
+};
+
+// Immutable table of every clip in the game, read from animations.csv once per process
+class AnimationLibrary {
+public:
+    static const AnimationLibrary& shared();
+
+    bool loadFromFile(const std::string& path);
+    const AnimationClip& get(const std::string& name) const;
+    bool contains(const std::string& name) const { return clips.find(name) != clips.end(); }
+
+private:
+    bool load(std::istream& file, const std::string& path);
+
+    std::unordered_map<std::string, AnimationClip> clips;
+};
+
+// Per-entity playback state: a clip pointer, a frame index and the time carried
+// over into the current frame
+class AnimationPlayer {
+public:
+    bool play(const AnimationClip& clip, bool restart = false);
+    bool advance(float deltaTime);
+    void restart();
+
+    void setPaused(bool value) { paused = value; }
+    bool isPaused() const { return paused; }
+    bool isFinished() const { return finished; }
+    bool isPlaying(const AnimationClip& clip) const { return current == &clip; }
+
+    const AnimationClip* getClip() const { return current; }
+    size_t getFrameIndex() const { return index; }
+    const AnimationFrame& frame() const { return current->frames[index]; }
+    const sf::IntRect& frameRect() const { return frame().rect; }
+    const sf::IntRect& hitbox() const { return frame().hitbox; }
+
+private:
+    const AnimationClip* current{nullptr};
+    size_t index{0};
+    float elapsed{0.0f};
+    bool finished{false};
+    bool paused{false};
+};
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef ASSETLOADER_H
+#define ASSETLOADER_H
+
+#include <SFML/Graphics.hpp>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <istream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AudioMixer.h"
+#include "StartupTimeline.h"
+
+class SoundManager;
+
+// Loads level assets in the background while the intro is on screen. Worker
+// threads decode images, parse map tables and decode sounds; the results queue
+// up for the main thread, which uploads textures and registers sounds a few at
+// a time per frame through pump()
+class AssetLoader {
+public:
+    using Table = std::vector<std::vector<int>>;
+
+    AssetLoader() = default;
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    void queueImage(const std::string& path);
+    void queueTable(const std::string& path);
+    void queueSound(const std::string& name, const std::string& path);
+    void start();
+
+    // Headless loaders skip image decoding and upload: every image becomes an
+    // empty texture, so maps and sprites keep a sheet to point at without a GPU
+    void setHeadless(bool enabled) { headless = enabled; }
+    void setSounds(SoundManager* target) { sounds = target; }   // where decoded sounds are registered
+    void setTimeline(StartupTimeline* target) { timeline = target; }   // before anything is queued
+
+    void pump(float budgetMs);
+    bool isDone() const { return finished == total; }
+    float progress() const { return total == 0 ? 1.0f : static_cast<float>(finished) / static_cast<float>(total); }
+
+    const sf::Texture* texture(const std::string& path) const;
+    const Table* table(const std::string& path) const;
+
+    static Table parseTable(const std::string& path);
+    static Table parseTable(std::istream& in);
+
+private:
+    // A finished job waiting for the main thread
+    struct Result {
+        enum class Kind { IMAGE, TABLE, SOUND } kind{Kind::IMAGE};
+        std::string path;
+        std::string name;
+        bool ok{false};
+        sf::Image image;
+        Table table;
+        PcmClip clip;
+        double startMs{0.0};      // the rest only when there is a timeline
+        double ioMs{0.0};
+        double decodeMs{0.0};
+        size_t bytes{0};
+    };
+
+    void queue(std::function<Result()> job);
+    void workerLoop();
+    void finish(Result& result);
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<Result()>> jobs;
+    std::deque<Result> results;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping{false};
+    bool headless{false};
+    SoundManager* sounds{nullptr};
+    StartupTimeline* timeline{nullptr};
+
+    size_t total{0};
+    size_t finished{0};
+
+    std::map<std::string, sf::Texture> textures;
+    std::map<std::string, Table> tables;
+};
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef ASSETPACK_H
+#define ASSETPACK_H
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "MappedFile.h"
+
+// Every asset of the game in one file: a header, an index sorted by path hash
+// and the file contents, each aligned to 16 bytes. The whole pack is mapped
+// read-only and loaders read straight out of the mapping. Paths are matched
+// case-insensitively, with "./" and backslashes ignored. The paths themselves
+// follow the index, for listing only
+class AssetPack {
+public:
+    static constexpr uint32_t VERSION = 2;
+    static constexpr size_t DATA_ALIGNMENT = 16;
+
+    enum class Type : uint32_t { OTHER, IMAGE, FONT, TABLE, SOUND };
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t namesSize;     // bytes of NUL-terminated paths after the index, in index order
+    };
+
+    struct Entry {
+        uint64_t pathHash;
+        uint64_t offset;        // from the start of the pack
+        uint64_t size;
+        uint64_t checksum;      // FNV-1a of the contents
+        Type type;
+        uint32_t reserved;
+    };
+
+    struct Blob {
+        const uint8_t* data{nullptr};
+        size_t size{0};
+        uint64_t checksum{0};
+    };
+
+    bool open(const std::string& path);
+    bool isOpen() const { return file.isOpen(); }
+    bool find(const std::string& path, Blob& blob) const;
+    bool verify(const Entry& entry) const;
+    const std::vector<Entry>& getEntries() const { return entries; }
+    const std::vector<std::string>& getNames() const { return names; }
+
+    // The packs loaders fall back to, newest first; loose files are used when
+    // none has the path. Every owner unmounts only its own pack, so engines with
+    // separate packs can come and go in any order
+    static void mount(const AssetPack* pack);
+    static void unmount(const AssetPack* pack);
+    static bool lookup(const std::string& path, Blob& blob);
+
+    // Loads an SFML resource from the mounted pack, or the loose file without
+    // one: loadFrom* for textures and images, openFrom* for fonts, music and
+    // sound files
+    template <typename T>
+    static bool load(const std::string& path, T& target);
+
+    // Hands read() the asset as a stream and returns what it returns; false
+    // without calling it if the asset is nowhere to be found
+    template <typename Read>
+    static bool read(const std::string& path, Read&& read);
+
+    static std::string normalize(const std::string& path);
+    static uint64_t hash(const void* data, size_t size);
+    static uint64_t hashPath(const std::string& path);
+    static Type typeOf(const std::string& path);
+
+private:
+    template <typename T, typename = void>
+    struct Opens : std::false_type {};
+    template <typename T>
+    struct Opens<T, std::void_t<decltype(std::declval<T&>().openFromMemory(nullptr, size_t{}))>> : std::true_type {};
+
+    MappedFile file;
+    std::vector<Entry> entries;
+    std::vector<std::string> names;
+};
+
+template <typename T>
+bool AssetPack::load(const std::string& path, T& target) {
+    Blob blob;
+    const bool packed = lookup(path, blob);
+    if constexpr (Opens<T>::value) {
+        return packed ? target.openFromMemory(blob.data, blob.size) : target.openFromFile(path);
+    } else {
+        return packed ? target.loadFromMemory(blob.data, blob.size) : target.loadFromFile(path);
+    }
+}
+
+template <typename Read>
+bool AssetPack::read(const std::string& path, Read&& read) {
+    Blob blob;
+    if (lookup(path, blob)) {
+        std::istringstream packed(std::string(reinterpret_cast<const char*>(blob.data), blob.size));
+        return read(packed);
+    }
+
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+    return read(file);
+}
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef AUDIOMIXER_H
+#define AUDIOMIXER_H
+
+#include <SFML/Audio.hpp>
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Decoded sound effect in the mixer's format: interleaved stereo floats at SAMPLE_RATE.
+// The samples are either owned by storage or live in a mapped cache file
+struct PcmClip {
+    const float* samples{nullptr};
+    size_t length{0};
+    std::vector<float> storage;
+    int priority{0};
+
+    PcmClip() = default;
+    PcmClip(PcmClip&&) = default;
+    PcmClip& operator=(PcmClip&&) = default;
+    PcmClip(const PcmClip&) = delete;
+    PcmClip& operator=(const PcmClip&) = delete;
+
+    bool empty() const { return length == 0; }
+};
+
+// One audio stream that every sound effect is mixed into. Voices are a fixed
+// array; when all are busy a new sound replaces the lowest-priority, oldest
+// one, or is dropped if everything playing matters more
+class AudioMixer final : public sf::SoundStream {
+public:
+    static constexpr unsigned SAMPLE_RATE = 44100;
+    static constexpr unsigned CHANNELS = 2;
+    static constexpr size_t BLOCK_FRAMES = 512;
+    static constexpr size_t MAX_VOICES = 16;
+
+    AudioMixer();
+    ~AudioMixer() override;
+
+    AudioMixer(const AudioMixer&) = delete;
+    AudioMixer& operator=(const AudioMixer&) = delete;
+
+    bool trigger(const PcmClip& clip);
+    void stopAll();
+
+    static PcmClip convert(const int16_t* samples, uint64_t sampleCount, unsigned channels, unsigned sampleRate);
+
+protected:
+    bool onGetData(Chunk& data) override;
+    void onSeek(sf::Time timeOffset) override;
+
+private:
+    struct Voice {
+        const float* samples{nullptr};
+        size_t length{0};
+        size_t cursor{0};
+        int priority{0};
+        uint64_t started{0};
+    };
+
+    static constexpr size_t BLOCK_SAMPLES = BLOCK_FRAMES * CHANNELS;
+
+    std::mutex voiceMutex;
+    std::array<Voice, MAX_VOICES> voices{};
+    uint64_t triggerCount{0};
+
+    std::array<float, BLOCK_SAMPLES> mixBuffer{};
+    std::array<int16_t, BLOCK_SAMPLES> outputBuffer{};
+};
+
+#endif
@@ -3,14 +3,18 @@
 
 #include <SFML/Graphics.hpp>
 #include <vector>
+#include "AnimationClip.h"
+#include "SpriteArchetype.h"
+#include "RenderSnapshot.h"
 
 class BaseSprite {
 public:
-    BaseSprite(const sf::Vector2f& pos, bool animated = false);
+    BaseSprite(const SpriteArchetype& type, const sf::Vector2f& pos);
     virtual ~BaseSprite() = default;
 
     virtual void update(float deltaTime);
-    virtual void render(sf::RenderWindow& window);
+    virtual void render(RenderSnapshot& target);
+    void advanceAnimation(float deltaTime);
     void setPosition(const sf::Vector2f& pos);
     void setOpacity(uint8_t alpha);
 
@@ -19,15 +23,12 @@ public:
 
 protected:
     virtual void initializeFrames() {}
+    void playClip(const AnimationClip& clip, bool restart = false);
 
+    const SpriteArchetype& archetype;
     sf::Vector2f position;
-    sf::Texture texture;
     sf::Sprite sprite;
-    std::vector<sf::IntRect> frames;
-    size_t currentFrame{0};
-    float frameTime{0.1f};
-    float animationTimer{0.0f};
-    bool isAnimated{false};
+    AnimationPlayer animation;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -2,12 +2,12 @@
 #define BUZZERENEMY_H
 
 #include "BaseSprite.h"
+#include "EngineContext.h"
 #include "AnimalSprite.h"
 #include "GameMap.h"
 
 class BuzzerEnemy final : public BaseSprite {
 private:
-    void initializeFrames() override;
     float moveDistance;
     float originalX;
     bool movingRight;
@@ -31,24 +31,19 @@ private:
     };
     std::vector<Projectile> projectiles;
 
-    sf::IntRect normalFrames[4];
-    sf::IntRect shootingFrame;
-    sf::IntRect projectileFrame;
-
     void updateProjectiles(float deltaTime);
     sf::FloatRect getDetectionBox() const;
-    void updateAnimation(float deltaTime);
     void updateMovement(float deltaTime);
 
 public:
-    explicit BuzzerEnemy(const sf::Vector2f& pos);
+    BuzzerEnemy(const SpriteArchetypes& types, const sf::Vector2f& pos);
     ~BuzzerEnemy() override = default;
     float attackCooldown = 0.0f;
     static constexpr float ATTACK_COOLDOWN = 3.0f;
     void update(float deltaTime) override;
-    void render(sf::RenderWindow& window) const ;
+    void render(RenderSnapshot& target) const ;
     sf::FloatRect getCollisionBounds() const;
-    void die();
+    void die(const EngineContext& context);
     bool isAlive() const { return isActive; }
     void shoot(const sf::Vector2f& targetPos);
     bool checkPlayerInRange(const sf::FloatRect& playerBounds) const;
@@ -7,25 +7,20 @@ class CheckpointSprite final : public BaseSprite {
 private:
     void initializeFrames() override;
     bool isActivated = false;
-    bool hasPlayedAnimation = false;
 
 public:
-    explicit CheckpointSprite(const sf::Vector2f& pos);
+    CheckpointSprite(const SpriteArchetypes& types, const sf::Vector2f& pos);
     ~CheckpointSprite() override = default;
-    void update(float deltaTime) override;
     void activate();
     bool isActive() const { return isActivated; }
     sf::FloatRect getCollisionBounds() const;
 
     void reset() {
         isActivated = false;
-        hasPlayedAnimation = false;
-        currentFrame = 0;
-        animationTimer = 0.0f;
-        sprite.setTextureRect(frames[0]);
+        initializeFrames();
     }
 
-    static void createCheckpointGroup(std::vector<CheckpointSprite*>& sprites, const std::vector<sf::Vector2f>& positions);
+    static void createCheckpointGroup(std::vector<CheckpointSprite*>& sprites, const std::vector<sf::Vector2f>& positions, const SpriteArchetypes& types);
 };
 
 #endif
\ No newline at end of file
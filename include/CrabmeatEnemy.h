@@ -2,12 +2,12 @@
 #define CRABMEATENEMY_H
 
 #include "BaseSprite.h"
+#include "EngineContext.h"
 #include "GameMap.h"
 #include "AnimalSprite.h"
 
 class CrabmeatEnemy final : public BaseSprite {
 private:
-    void initializeFrames() override;
     float pauseTimer = 0.0f;
     float originalX;
     bool movingRight = true;
@@ -15,30 +15,19 @@ private:
     GameMap* collisionMap = nullptr;
     std::unique_ptr<AnimalSprite> freedAnimal;
 
-
-    float animationTimer = 0.0f;
-    int currentFrame = 0;
-    static constexpr float FRAME_TIME = 0.15f;
-
-
-    std::vector<sf::IntRect> walkFrames;
-    std::vector<sf::IntRect> attackFrames;
-
     static constexpr float TURN_PAUSE_DURATION = 0.5f;
 
-    void updateAnimation(float deltaTime);
-
 public:
-    explicit CrabmeatEnemy(const sf::Vector2f& pos);
+    CrabmeatEnemy(const SpriteArchetypes& types, const sf::Vector2f& pos);
     ~CrabmeatEnemy() override = default;
     AnimalSprite* getFreedAnimal() const { return freedAnimal.get(); }
     void update(float deltaTime) override;
     void updatePatrolMovement(float deltaTime);
-    void die();
+    void die(const EngineContext& context);
     bool isAlive() const;
     sf::FloatRect getCollisionBounds() const;
     void setCollisionMap(GameMap* map) { collisionMap = map; }
-    void render(sf::RenderWindow& window) const ;
+    void render(RenderSnapshot& target) const ;
 
 
     struct Projectile {
@@ -50,7 +39,6 @@ public:
     };
 
     std::vector<Projectile> projectiles;
-    sf::IntRect projectileFrame = sf::IntRect({120, 150}, {16, 16});  // Same as Buzzer's projectile
     bool isShooting = false;
     float shootingTimer = 0.0f;
     float attackCooldown = 0.0f;
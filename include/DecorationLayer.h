@@ -0,0 +1,53 @@
+#ifndef DECORATIONLAYER_H
+#define DECORATIONLAYER_H
+
+#include <SFML/Graphics.hpp>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "AnimationClip.h"
+#include "RenderSnapshot.h"
+
+// Scenery with no behaviour (flowers, bridges, spike art) baked into chunked vertex
+// arrays at load time, one set of chunks per sheet. Animated pieces share one
+// playhead per clip and only get their texture coordinates rewritten
+class DecorationLayer {
+public:
+    explicit DecorationLayer(float chunkSize = 1024.0f) : chunkSize(chunkSize) {}
+
+    void add(const sf::Texture& texture, const sf::IntRect& rect, const sf::Vector2f& pos);
+    void add(const sf::Texture& texture, const AnimationClip& clip, const sf::Vector2f& pos);
+    void clear();
+
+    void update(float deltaTime);
+    void render(RenderSnapshot& target) const;
+
+private:
+    using ChunkKey = std::pair<int, int>;
+
+    struct Sheet {
+        const sf::Texture* texture{nullptr};
+        std::map<ChunkKey, sf::VertexArray> chunks;
+    };
+
+    struct QuadRef {
+        sf::VertexArray* chunk;
+        size_t firstVertex;
+    };
+
+    struct AnimatedClip {
+        AnimationPlayer animation;
+        std::vector<QuadRef> quads;
+    };
+
+    Sheet& sheetFor(const sf::Texture& texture);
+    QuadRef appendQuad(Sheet& sheet, const sf::Vector2f& pos, const sf::IntRect& rect);
+    static void setTexCoords(const QuadRef& quad, const sf::IntRect& rect);
+
+    float chunkSize;
+    std::vector<std::unique_ptr<Sheet>> sheets;
+    std::map<const AnimationClip*, AnimatedClip> animated;
+};
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef DYNAMICRESOLUTION_H
+#define DYNAMICRESOLUTION_H
+
+// Picks the world render scale from recent frame times. It steps down quickly
+// when frames run over budget and climbs back slowly once there is clear headroom,
+// so the scale does not bounce between two steps every other frame
+class DynamicResolution {
+public:
+    explicit DynamicResolution(float budgetMs = 16.6f) : budgetMs(budgetMs) {}
+
+    void setBudget(float ms) { budgetMs = ms; }
+    float getBudget() const { return budgetMs; }
+    void setEnabled(bool value);
+    bool isEnabled() const { return enabled; }
+
+    float update(float frameMs, float workMs);
+    float getScale() const { return scale; }
+
+    static constexpr float MIN_SCALE = 0.5f;
+    static constexpr float SCALE_STEP = 0.125f;
+
+private:
+    float budgetMs;
+    float scale{1.0f};
+    float averageFrameMs{0.0f};
+    float averageWorkMs{0.0f};
+    int framesOver{0};
+    int framesUnder{0};
+    bool enabled{true};
+
+    static constexpr float SMOOTHING = 0.1f;
+    static constexpr float MAX_SAMPLE_MS = 250.0f;
+    static constexpr float OVER_BUDGET = 1.1f;    // frame interval above this fraction of the budget counts as slow
+    static constexpr float UNDER_BUDGET = 0.6f;   // work time below this fraction leaves room to scale back up
+    static constexpr int FRAMES_TO_DROP = 10;
+    static constexpr int FRAMES_TO_RAISE = 90;
+};
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef ENGINECONTEXT_H
+#define ENGINECONTEXT_H
+
+#include <array>
+#include <cstddef>
+#include "Random.h"
+#include "SoundManager.h"
+
+class LevelData;
+
+// What game code used to reach through globals, owned by one engine and handed
+// down to whatever it builds. No two engines share one, so several can step at
+// once on different threads. A headless engine has no sound manager, and
+// playing an effect is then a no-op. Every roll that changes play comes from
+// random, so a run is fixed by its seed and inputs
+struct EngineContext {
+    const LevelData* level{nullptr};
+    SoundManager* sounds{nullptr};
+    Random* random{nullptr};
+    std::array<SoundId, static_cast<size_t>(SoundEffect::COUNT)> effects;
+
+    EngineContext() { effects.fill(NO_SOUND); }
+
+    void play(SoundEffect effect) const {
+        if (sounds) sounds->playSound(effects[static_cast<size_t>(effect)]);
+    }
+};
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef ENVIRONMENTPOOL_H
+#define ENVIRONMENTPOOL_H
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+#include "GameEngine.h"
+#include "JobSystem.h"
+
+// N windowless engines stepped side by side, for bots and regression farms.
+// The level is loaded once, without pixels or sound, and its LevelData shared
+// read-only by every engine; each builds only its own actors on top of it.
+// step() hands one action to each engine and steps them all in parallel on a
+// job system. Engines share nothing mutable, so an engine's observations do not
+// depend on which thread stepped it or how many others are running
+class EnvironmentPool {
+public:
+    using Action = PlayerInput;
+
+    // What a bot sees of one engine after a step
+    struct Observation {
+        sf::Vector2f position;
+        sf::Vector2f velocity;
+        int rings{0};
+        int lives{0};
+        int score{0};
+        float time{0.0f};
+        GameState state{GameState::PLAYING};
+        bool done{false};   // game over or level complete; reset() to play again
+    };
+
+    static constexpr float STEP_SECONDS = 1.0f / 60.0f;
+
+    explicit EnvironmentPool(size_t count, unsigned workerCount = JobSystem::AUTO_WORKERS);
+    ~EnvironmentPool();
+
+    EnvironmentPool(const EnvironmentPool&) = delete;
+    EnvironmentPool& operator=(const EnvironmentPool&) = delete;
+
+    size_t size() const { return engines.size(); }
+    const std::vector<Observation>& step(const std::vector<Action>& actions);
+    const std::vector<Observation>& getObservations() const { return observations; }
+    void reset(size_t index);
+    void resetAll();
+
+    GameEngine& engine(size_t index) { return *engines[index]; }
+
+private:
+    void observe(size_t index);
+
+    AssetPack pack;       // declared first, so it outlives everything reading from it
+    std::shared_ptr<const LevelData> level;
+    std::vector<std::unique_ptr<GameEngine>> engines;
+    std::vector<Observation> observations;
+    JobSystem jobs;
+};
+
+#endif
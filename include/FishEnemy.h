@@ -2,6 +2,7 @@
 #define FISHENEMY_H
 
 #include "BaseSprite.h"
+#include "EngineContext.h"
 #include "AnimalSprite.h"
 #include "GameMap.h"
 
@@ -20,17 +21,17 @@ private:
     GameMap* collisionMap = nullptr;
 
 public:
-    FishEnemy(const sf::Vector2f& pos, float targetY);
+    FishEnemy(const SpriteArchetypes& types, const sf::Vector2f& pos, float targetY);
     ~FishEnemy() override = default;
 
     void update(float deltaTime) override;
     void updateVerticalMovement(float deltaTime);
     sf::FloatRect getCollisionBounds() const;
-    void render(sf::RenderWindow& window) const;
+    void render(RenderSnapshot& target) const;
     void setCollisionMap(GameMap* map) { collisionMap = map; }
 
     bool isAlive() const { return isActive; }
-    void die();
+    void die(const EngineContext& context);
     void handleCollision(Player* player);
     AnimalSprite* getFreedAnimal() const { return freedAnimal.get(); }
     void reset();
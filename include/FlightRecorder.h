@@ -0,0 +1,52 @@
+#ifndef FLIGHTRECORDER_H
+#define FLIGHTRECORDER_H
+
+#include <SFML/System.hpp>
+#include <array>
+#include <cstddef>
+#include <string>
+#include "GameState.h"
+#include "RenderSnapshot.h"
+
+// Always-on record of the last CAPACITY drawn frames: zone times, input,
+// entity and allocation counts. Recording copies one fixed-size sample into a
+// ring, with no allocation or locking. A frame slower than the threshold dumps
+// the ring to a timestamped Chrome trace (chrome://tracing, Perfetto); so does
+// main when it catches an exception. Owned by main, so it outlives the engine.
+// Fed on the render side; dump() may only be called from that thread or once
+// the engine is gone
+class FlightRecorder {
+public:
+    static constexpr size_t CAPACITY = 600;          // ten seconds at 60 fps
+    static constexpr float SLOW_FRAME_MS = 50.0f;    // three frames at 60 fps
+
+    explicit FlightRecorder(std::string directory = ".");
+
+    void setThreshold(float ms) { slowFrameMs = ms; }
+
+    // One drawn frame; frameMs is the time since the last one. Dumps when it is
+    // slow, unless the last dump was too recent to have fresh frames in it
+    void record(GameState state, const FrameStats& stats, float frameMs);
+
+    // Writes every frame held to trace-<time>.json; returns the path, or an
+    // empty string if there was nothing to write or the write failed
+    std::string dump(const std::string& reason);
+
+private:
+    struct Sample {
+        double endMs;          // since the recorder started, when drawing finished
+        float frameMs;
+        GameState state;
+        FrameStats stats;
+    };
+
+    std::array<Sample, CAPACITY> samples{};
+    size_t next{0};
+    size_t filled{0};
+    size_t sinceDump{CAPACITY};   // frames recorded since the last dump
+    float slowFrameMs{SLOW_FRAME_MS};
+    std::string directory;
+    sf::Clock clock;
+};
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef FRAMEGRAPH_H
+#define FRAMEGRAPH_H
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstddef>
+#include "Hud.h"
+#include "RenderSnapshot.h"
+
+// Stall overlay: the last HISTORY frames as stacked columns of poll, update and
+// render time, p50/p99 of their totals, and the latest frame's counters. Bars
+// and text alike go into one vertex array over a glyph atlas like the HUD's, so
+// showing it costs a single draw call. Render side only
+class FrameGraph {
+public:
+    static constexpr size_t HISTORY = 600;
+
+    bool init(const sf::Font& font, sf::Vector2u windowSize);
+    void push(const FrameStats& stats);     // every frame, shown or not
+    void render(sf::RenderTarget& target);
+
+private:
+    static constexpr unsigned CHARACTER_SIZE = 14;
+
+    void addQuad(sf::Vector2f position, sf::Vector2f size, sf::Color color);
+    float addText(const char* text, sf::Vector2f pen, sf::Color color);
+    float percentile(float fraction);
+
+    GlyphAtlas atlas;
+    std::array<FrameStats, HISTORY> history{};
+    std::array<float, HISTORY> scratch{};
+    size_t next{0};
+    size_t filled{0};
+    sf::VertexArray vertices{sf::PrimitiveType::Triangles};
+    sf::Vector2f origin;      // top-left of the graph
+    bool ready{false};
+};
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef FROZENFRAME_H
+#define FROZENFRAME_H
+
+#include <SFML/Graphics.hpp>
+
+// The last gameplay frame, captured once when a menu or end screen opens and
+// redrawn as a single sprite behind it until gameplay resumes
+class FrozenFrame {
+public:
+    sf::RenderTarget* beginCapture(const sf::Vector2u& size);
+    void endCapture();
+
+    void invalidate() { valid = false; }
+    bool isValid() const { return valid; }
+
+    void render(sf::RenderTarget& target) const;
+
+private:
+    sf::RenderTexture texture;
+    bool valid{false};
+};
+
+#endif
@@ -5,16 +5,17 @@
 #include <SFML/Audio.hpp>
 #include <vector>
 #include <memory>
+#include <atomic>
 #include <optional>
 #include <map>
 
 #include "GameState.h"
+#include "PlayerInput.h"
 #include "GameMap.h"
 #include "Player.h"
 #include "GameStateManager.h"
-#include "FlowerSprite.h"
-#include "BridgeSprite.h"
 #include "RingSprite.h"
+#include "RingField.h"
 #include "SpikeSprite.h"
 #include "CheckpointSprite.h"
 #include "BuzzerEnemy.h"
@@ -24,20 +25,60 @@
 #include "PowerUpSprite.h"
 #include "PlatformSprite.h"
 #include "SpringSprite.h"
+#include "WorldRenderTarget.h"
+#include "DynamicResolution.h"
+#include "FrozenFrame.h"
+#include "Hud.h"
+#include "FrameGraph.h"
+#include "FlightRecorder.h"
+#include "AllocationCounter.h"
+#include "ParticleSystem.h"
+#include "AssetLoader.h"
+#include "AssetPack.h"
+#include "LevelData.h"
+#include "RenderPipeline.h"
+#include "JobSystem.h"
+#include "EngineContext.h"
+#include "Random.h"
+#include "Replay.h"
+#include "StateHash.h"
+#include "Metrics.h"
+#include "StartupTimeline.h"
 
 class Player;
 
 class GameEngine final {
 public:
-    GameEngine();
+    explicit GameEngine(StartupTimeline* startup = nullptr);   // startup, if given, must outlive the engine
+    explicit GameEngine(std::shared_ptr<const LevelData> sharedLevel);   // headless, see the constructor
     ~GameEngine();
 
+    static std::shared_ptr<const LevelData> loadHeadlessLevel(AssetPack& sharedPack);
+
 
     bool running() const;
     void update();
     void render();
     void poll();
     void resetGame();
+    void close();
+    void step(const PlayerInput& input, float deltaTime);
+    bool isHeadless() const { return headless; }
+    bool isLevelLoaded() const { return levelLoaded; }
+
+    void startRecording();
+    const Replay* getRecording() const { return recording.get(); }
+    std::optional<Replay::Divergence> playReplay(const Replay& replay);
+    void stepReplay(const Replay::Frame& frame);
+    void setSeed(uint64_t seed) { random.reseed(seed); }
+    StateHash hashState() const;
+    void recordFrame(RenderSnapshot& frame);
+
+    Metrics& getMetrics() { return metrics; }
+
+    void setFlightRecorder(FlightRecorder* recorder) { flightRecorder = recorder; }   // before setPipelined
+    void setPipelined(bool enabled);
+    bool isPipelined() const { return pipeline.isThreaded(); }
 
 
     static constexpr float LEVEL_END_X = 10000.0f;
@@ -45,34 +86,43 @@ public:
     static constexpr float CAMERA_Y_MAX_BEFORE_THRESHOLD = 1023.0f;
     static constexpr float CAMERA_Y_MAX_AFTER_THRESHOLD = 1280.0f;
     static constexpr int INITIAL_LIVES = 3;
+    static constexpr int ENEMY_SCORE = 100;
+    static constexpr unsigned NATIVE_WIDTH = 358;   // world view is 1.4 x 1 tiles of 256px
+    static constexpr unsigned NATIVE_HEIGHT = 256;
 
 
     void SetCurrentState(GameState state) { currentState = state; }
     GameState GetCurrentState() const { return currentState; }
+    int getScore() const { return score; }
+    int getLives() const { return currentLives; }
+    float getLevelTime() const { return levelTime; }
 
     void resetRings();
     void resetEnemies();
     void storeInitialEnemyPositions();
 
     void setGodMode(bool enabled);
+    void setFrameBudget(float ms) { dynamicResolution.setBudget(ms); }
+    void setDynamicResolution(bool enabled) { dynamicResolution.setEnabled(enabled); }
 
 
 
-    void updateLivesDisplay();
     void handlePlayerDeath();
     void respawnPlayer();
     void increasePlayerLives(int amount);
     Player* GetPlayer() { return player; }
 
 
-    void updateRingDisplay();
+    void addScore(int points);
     void updateScatteredRings(float deltaTime);
-    void renderScatteredRings();
     void CreateScatteredRing(const sf::Vector2f& position, const sf::Vector2f& velocity);
 
     const std::vector<SpikeSprite*>& GetSpikeSprites() const { return spikeSprites; }
-    void initFlowerSprites();
-    void initPowerUpSprites();
+    void addDecoration(SpriteKind kind, const sf::Vector2f& pos);
+    void spawnBadniks();
+    void clearBadniks();
+    void spawnPowerUps();
+    void clearPowerUps();
     void handlePowerUpEffect(PowerUpSprite::PowerUpType type);
 
     std::vector<SpringSprite*> springSprites;
@@ -81,7 +131,7 @@ public:
 
     class ScatteredRing {
     public:
-        ScatteredRing(const sf::Vector2f& pos, const sf::Vector2f& vel);
+        ScatteredRing(const SpriteArchetypes& types, const sf::Vector2f& pos, const sf::Vector2f& vel);
 
         bool isActive() const { return active; }
         bool isOnFloor() const { return onFloor; }
@@ -108,6 +158,13 @@ public:
         friend class GameEngine;
     };
 
+    // A badnik's overlap with the player this frame, worked out in parallel
+    struct BadnikContact {
+        bool touching{false};
+        bool inRange{false};
+        bool projectileHit{false};
+    };
+
     struct EnemyInitialState {
         sf::Vector2f position;
         bool wasAlive;
@@ -121,6 +178,7 @@ public:
 
 private:
 
+    AssetPack pack;   // declared first so every member reading from it goes away before it
     sf::RenderWindow* window{nullptr};
     sf::VideoMode videoMode;
     sf::View view;
@@ -136,6 +194,47 @@ private:
     uint64_t pauseTime{0};
     bool isGodMode{false};
     bool isGridMapVisible{false};
+    bool isPixelPerfect{false};
+    WorldRenderTarget worldTarget{sf::Vector2u(NATIVE_WIDTH, NATIVE_HEIGHT)};
+    DynamicResolution dynamicResolution;
+    FrozenFrame frozenFrame;
+    RenderPipeline pipeline;
+    uint32_t worldRevision{0};
+    bool wasFrozen{false};
+    std::atomic<uint32_t> frozenRevision{0};    // world revision the frozen frame holds, set by the render side
+    JobSystem jobs;
+    std::vector<BadnikContact> contacts;
+    std::shared_ptr<AssetLoader> assets;        // the window's loader; headless engines have none
+    std::shared_ptr<const LevelData> level;     // shared with restarts and other engines
+    Metrics metrics;                            // before everything holding its instruments
+    Metrics::Counter* collisionQueries{nullptr};
+    Metrics::Counter* tilesDrawn{nullptr};
+    Metrics::Counter* spritesDrawn{nullptr};
+    Metrics::Gauge* entitiesActive{nullptr};
+    Metrics::Counter* soundsPlayed{nullptr};
+    Metrics::Counter* bytesAllocated{nullptr};
+    Metrics::Histogram* frameMs{nullptr};
+    std::unique_ptr<SoundManager> sounds;       // none when headless
+    EngineContext context;                      // handed to the player and every badnik
+    Random random;
+    std::unique_ptr<Replay> recording;          // only while recording
+    bool resetPending{false};                   // a restart the next recorded step should carry
+    bool headless{false};
+    StartupTimeline* startup{nullptr};          // owned by main; none when headless
+    bool levelLoaded{false};
+    sf::Clock stepClock;
+    sf::Clock frameClock;
+    float lastFrameMs{0.0f};
+    float lastRenderMs{0.0f};         // render side
+    size_t drawCalls{0};              // render side: world batches and HUD this frame
+    FrameGraph frameGraph;            // render side
+    FlightRecorder* flightRecorder{nullptr};   // render side, owned by main
+    bool isFrameGraphVisible{false};
+    size_t entitiesTicked{0};
+    PlayerInput lastInput;
+    size_t lastAllocationCount{0};
+    size_t lastAllocationBytes{0};
+    uint64_t lastCollisionQueries{0};
 
     GameMap* map{nullptr};
     GameMap* bgr{nullptr};
@@ -149,14 +248,13 @@ private:
 
     sf::Font gameFont;
     sf::Font introFont;
-    sf::Text* ringCountText{nullptr};
-    sf::Text* livesCountText{nullptr};
-    int displayedRingCount{0};
+    Hud hud;
     int currentLives{INITIAL_LIVES};
+    int score{0};
+    float levelTime{0.0f};
 
-    std::vector<FlowerSprite*> flowerSprites;
-    std::vector<BridgeSprite*> bridgeSprites;
-    std::vector<RingSprite*> ringSprites;
+    ParticleSystem particles;
+    RingField ringField;
     std::vector<SpikeSprite*> spikeSprites;
     std::vector<CheckpointSprite*> checkpointSprites;
     std::vector<BuzzerEnemy*> buzzerEnemies;
@@ -171,21 +269,38 @@ private:
     void handleCheckpointActivation(const sf::Vector2f& checkpointPos);
     sf::Vector2f getSpawnPosition() const;
 
+    void initWindow();
+    void initViews();
+    void initMetrics();
+    void queueLevelAssets();
+    void updateLoading();
+    void initSounds();
     void initGameElements();
-    void initText();
+    void initHud();
     void initLifeDisplay();
 
-    void updateGameState();
+    void updateGameState(float deltaTime);
+    void updateAnimations(float deltaTime);
+    void updatePowerUpAuras(float deltaTime);
+    void stepBadniks(float deltaTime);
+    void onBadnikDestroyed(const sf::FloatRect& bounds);
     void constrainView();
     void constrainBackgroundView();
 
 
-    void renderPlayingState();
-    void renderPausedState();
+    // Simulation side: fills the snapshot the next drawn frame comes from. Reads
+    // the world and changes none of it
+    void recordPlayingState(RenderSnapshot& target);
+    void recordPausedState(RenderSnapshot& target);
+
+    // Render side: reads nothing but the snapshot and the render-only members
+    // (window, world target, frozen frame, HUD, dynamic resolution)
+    void drawFrame(const RenderSnapshot& frame);
+    void renderWorld(sf::RenderTarget& screen, const RenderSnapshot& frame);
+    void renderFrozenWorld(const RenderSnapshot& frame);
 
 
     void cleanup();
-    void cleanupText();
 };
 
 #endif
\ No newline at end of file
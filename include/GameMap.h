@@ -1,56 +1,92 @@
 #ifndef GAMEMAP_H
 #define GAMEMAP_H
 #include <SFML/Graphics.hpp>
+#include <memory>
 #include <vector>
-
-class GameMap {
-    sf::Texture texture;
-    sf::Sprite sprite;
-
-    int tileWidth;
-    int tileHeight;
-    int tileMargin;
-    int tileSpacing;
-    int totalTilesX;
-    int totalTilesY;
-
+#include "DecorationLayer.h"
+#include "Metrics.h"
+#include "RenderSnapshot.h"
+
+// One tile layer of a level as loaded: the tileset, the rectangles it is cut
+// into and the map table. Never changes once cut, so every GameMap drawn from
+// it, in any engine, reads the same one
+struct TileLayer {
+    const sf::Texture* tileset{nullptr};   // owned by the asset loader
+    int tileWidth{0};
+    int tileHeight{0};
     std::vector<sf::IntRect> tileRects;
-    std::vector<std::vector<int>> mapData;
+    std::vector<std::vector<int>> tiles;
 
-    void loadMap(const std::string &, const std::string &);
+    static TileLayer cut(int tileWidth, int tileHeight, int tileMargin, int tileSpacing,
+                         const sf::Texture* tileset, std::vector<std::vector<int>> data);
+};
+
+// A tile layer as one engine plays it: the shared layer plus this engine's
+// render caches and decorations
+class GameMap {
+    const TileLayer* layer;
+
+    // Tiles baked into one vertex array per CHUNK_TILES x CHUNK_TILES block,
+    // rebuilt only when the render scale changes
+    static constexpr int CHUNK_TILES = 8;
+    std::vector<sf::VertexArray> chunks;
+    int chunkColumns{0};
+    int chunkRows{0};
+    float chunkScale{0.0f};
+    DecorationLayer decorations;
+
+    // Collision overlay, one fill and one outline array per DEBUG_CHUNK_TILES block,
+    // built the first time the block comes into view. Snapshots hold them by
+    // reference, so they are never changed once built
+    struct DebugChunk {
+        bool built{false};
+        std::shared_ptr<const sf::VertexArray> fill;
+        std::shared_ptr<const sf::VertexArray> outline;
+    };
+    static constexpr int DEBUG_CHUNK_TILES = 128;
+    std::vector<DebugChunk> debugChunks;
+    int debugColumns{0};
+    float debugScale{0.0f};
+
+    Metrics::Counter* queryCounter{nullptr};   // bumped by checkCollision(), from any job
+
+    void buildChunks(float scale);
+    void buildDebugChunk(DebugChunk& chunk, int chunkX, int chunkY, float scale) const;
 
 public:
-    GameMap(int tileWidth, int tileHeight, int tileMargin, int tileSpacing,
-            const std::string &tex_path, const std::string &csv_path);
+    explicit GameMap(const TileLayer& layer);
     ~GameMap();
 
 
     static void update();
-    size_t getMapWidth() const { return !mapData.empty() ? mapData[0].size() : 0; }
-    size_t getMapHeight() const { return mapData.size(); }
+    size_t getMapWidth() const { return !layer->tiles.empty() ? layer->tiles[0].size() : 0; }
+    size_t getMapHeight() const { return layer->tiles.size(); }
 
 
 
     bool isSolidTile(const sf::Vector2i& tilePos) const;
     bool checkCollision(const sf::FloatRect& bounds, float verticalVelocity) const;
+    void setQueryCounter(Metrics::Counter* counter) { queryCounter = counter; }
 
 
 
     sf::Vector2i worldToTile(const sf::Vector2f& worldPos) const;
 
 
-    void renderCollisionDebug(sf::RenderWindow& window, float scale) const;
+    void renderCollisionDebug(RenderSnapshot& target, float scale, bool outlines = true);
+
 
 
+    void render(RenderSnapshot& target, float scale);
 
-    void render(sf::RenderWindow &window, float scale);
+    DecorationLayer& getDecorations() { return decorations; }
 
     int getTileType(const sf::Vector2i& tilePos) const {
         if (tilePos.x < 0 || tilePos.x >= static_cast<int>(getMapWidth()) ||
             tilePos.y < 0 || tilePos.y >= static_cast<int>(getMapHeight())) {
             return -1;
         }
-        return mapData[tilePos.y][tilePos.x];
+        return layer->tiles[tilePos.y][tilePos.x];
     }
 };
 #endif
\ No newline at end of file
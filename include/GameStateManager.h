@@ -4,9 +4,11 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
 #include "GameState.h"
+#include "RenderSnapshot.h"
 
 
 class GameEngine;
+class SoundManager;
 
 class GameStateManager final {
 private:
@@ -28,12 +30,15 @@ private:
     sf::Text* godModeText;
     sf::Text* completionText;
     sf::Text* gridMapText;
+    sf::Text* frameGraphText = nullptr;
+    sf::Text* pixelPerfectText;
 
 
     float fadeAlpha;
     bool fadingOut;
     float completionFadeAlpha;
     bool completionFadingIn;
+    sf::Clock completionFadeClock;
 
 
     sf::RectangleShape volumeSliderBg;
@@ -41,13 +46,21 @@ private:
     sf::RectangleShape musicToggle;
     sf::RectangleShape godModeToggle;
     sf::RectangleShape gridMapToggle;
+    sf::RectangleShape frameGraphToggle;
+    sf::RectangleShape pixelPerfectToggle;
+    sf::RectangleShape loadBarBg;
+    sf::RectangleShape loadBar;
+    float loadProgress{0.0f};
 
 
     sf::Music& bgMusic;
+    SoundManager& soundEffects;
     float& musicVolume;
     bool& isMusicMuted;
     bool& isGodMode;
     bool& isGridMapVisible;
+    bool& isFrameGraphVisible;
+    bool& isPixelPerfect;
     GameEngine* engineRef;
 
 
@@ -55,6 +68,7 @@ private:
     void initPauseMenu();
     void initCompletionScreen();
     void centerText(sf::Text* text, float yOffset = 0.0f);
+    void drawToggle(sf::RectangleShape toggle, bool on) const;
 
 
     void cleanup();
@@ -64,9 +78,10 @@ public:
     void resetCompletionScreen() {
         completionFadeAlpha = 0.0f;
         completionFadingIn = true;
+        completionFadeClock.restart();
     }
 
-    GameStateManager(sf::RenderWindow* window, sf::Music& music, float& volume, bool& muted, bool& godMode, bool& gridVisible);
+    GameStateManager(sf::RenderWindow* window, sf::Music& music, SoundManager& effects, float& volume, bool& muted, bool& godMode, bool& gridVisible, bool& frameGraph, bool& pixelPerfect);
     ~GameStateManager();
 
 
@@ -74,28 +89,33 @@ public:
     GameStateManager& operator=(const GameStateManager&) = delete;
 
 
+    void captureOverlay(OverlayState& overlay) const;
+
     void updateGameOverScreen();
-    void renderGameOverScreen() const;
+    void renderGameOverScreen(const OverlayState& overlay) const;
     void handleGameOverInput();
 
     void updateIntroScreen();
-    void renderIntroScreen() const;
+    void renderIntroScreen(const OverlayState& overlay) const;
     void handleIntroInput();
     bool isIntroFading() const { return fadingOut; }
     bool isIntroFadeComplete() const { return fadeAlpha <= 0.0f; }
+    void setLoadProgress(float progress);
 
 
     void updatePauseMenu();
-    void renderPauseMenu() const;
+    void renderPauseMenu(const OverlayState& overlay) const;
     void handlePauseMenuClick(int x, int y);
     void toggleMusic();
     void toggleGodMode();
     void toggleGridMap();
+    void toggleFrameGraph();
+    void togglePixelPerfect();
     void setMusicVolume(float volume);
 
 
     void updateCompletionScreen();
-    void renderCompletionScreen() const;
+    void renderCompletionScreen(const OverlayState& overlay) const;
     void handleCompletionInput();
 
 
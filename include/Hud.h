@@ -0,0 +1,72 @@
+#ifndef HUD_H
+#define HUD_H
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <string>
+
+// The glyphs of a character set at one size, fill and optionally outline, plus
+// a copy of the font page they sit on so later font use can't move them. Text
+// built from it is plain quads, so any amount of it is one draw call
+struct GlyphAtlas {
+    struct Quad {
+        sf::FloatRect bounds;
+        sf::IntRect textureRect;
+    };
+
+    struct Glyph {
+        Quad fill;
+        Quad outline;
+        float advance{0.0f};
+        bool loaded{false};
+    };
+
+    bool build(const sf::Font& font, unsigned characterSize, const std::string& characters, float outlineThickness = 0.0f);
+    const Glyph& operator[](char c) const { return glyphs[static_cast<unsigned char>(c) % glyphs.size()]; }
+
+    std::array<Glyph, 128> glyphs{};
+    sf::Texture texture;
+};
+
+// Score, time, rings and lives drawn from a private glyph atlas. Labels are
+// baked once; a counter's digit quads are only rewritten when its value changes
+class Hud {
+public:
+    enum class Counter { SCORE, TIME, RINGS, LIVES, COUNT };
+
+    bool init(const sf::Font& font, sf::Vector2u windowSize);
+
+    void setScore(int score);
+    void setTime(float seconds);
+    void setRings(int rings);
+    void setLives(int lives);
+
+    size_t render(sf::RenderTarget& target) const;   // returns the draw calls made
+
+private:
+    static constexpr unsigned CHARACTER_SIZE = 24;
+    static constexpr float OUTLINE_THICKNESS = 1.0f;
+    static constexpr int MAX_DIGITS = 7;
+
+    struct Field {
+        sf::Vector2f origin;        // top-left of the first digit slot
+        sf::Color color;
+        size_t firstVertex{0};      // first slot's vertices in both arrays
+        std::string shown;
+        int value{-1};
+    };
+
+    void addLabel(const std::string& label, sf::Vector2f position, sf::Color color);
+    void addField(Counter counter, sf::Vector2f position, sf::Color color);
+    void setField(Counter counter, int value, const std::string& text);
+    void writeQuad(size_t first, const GlyphAtlas::Quad& quad, sf::Vector2f pen, sf::Color color, bool outline);
+
+    GlyphAtlas atlas;
+    std::array<Field, static_cast<size_t>(Counter::COUNT)> fields{};
+    float digitAdvance{0.0f};
+    sf::VertexArray outlineVertices{sf::PrimitiveType::Triangles};
+    sf::VertexArray fillVertices{sf::PrimitiveType::Triangles};
+    bool ready{false};
+};
+
+#endif
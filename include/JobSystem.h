@@ -0,0 +1,70 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fixed set of worker threads, each with its own deque of jobs. A thread takes
+// from the back of its own deque and, once that is empty, steals from the front
+// of the others'. parallelFor() cuts an index range into chunks, deals them out
+// over the deques and has the calling thread work through them too, returning
+// once every chunk has run.
+// Bodies may only write to their own indices; whatever is shared (damage, ring
+// counts, deletions) is applied by the caller afterwards, in index order, so the
+// result does not depend on which thread ran what. Called from one thread only
+class JobSystem {
+public:
+    using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+    static constexpr unsigned AUTO_WORKERS = ~0u;    // picks from the core count
+
+    explicit JobSystem(unsigned workerCount = AUTO_WORKERS);   // 0 runs everything on the caller
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void parallelFor(size_t count, size_t grain, const RangeFunction& body);
+    unsigned getWorkerCount() const { return static_cast<unsigned>(workers.size()); }
+
+private:
+    // One parallelFor call; its jobs point back at it
+    struct Batch {
+        const RangeFunction* body{nullptr};
+        std::atomic<size_t> pending{0};
+        std::mutex errorMutex;
+        std::exception_ptr error;
+    };
+
+    struct Job {
+        Batch* batch;
+        size_t begin;
+        size_t end;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    bool findJob(size_t self, Job& job);
+    void run(const Job& job);
+    void workerLoop(size_t self);
+
+    std::vector<std::unique_ptr<Queue>> queues;   // queues[0] belongs to the calling thread
+    std::vector<std::thread> workers;
+    std::atomic<size_t> queued{0};
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    bool stopping{false};
+};
+
+#endif
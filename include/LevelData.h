@@ -0,0 +1,79 @@
+#ifndef LEVELDATA_H
+#define LEVELDATA_H
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+#include "AssetLoader.h"
+#include "GameMap.h"
+#include "PowerUpSprite.h"
+#include "SpriteArchetype.h"
+
+// Everything about the level that stays the same while it is played: the tile
+// layers, the sheet Sonic is cut from, where every actor starts and the teleport
+// triggers. Built once from loaded assets and handed out as a shared pointer to
+// const, so any number of engines, and every restart of each, read the same copy.
+// Engines keep only what changes in play: actors, render caches, scores
+class LevelData {
+public:
+    struct Scenery {
+        SpriteKind kind;
+        sf::Vector2f position;
+    };
+
+    struct RingGroup {
+        float startX;
+        float startY;
+        int count;
+    };
+
+    struct FishSpawn {
+        sf::Vector2f position;
+        float targetY;
+    };
+
+    struct PowerUpSpawn {
+        sf::Vector2f position;
+        PowerUpSprite::PowerUpType type;
+    };
+
+    // Touching trigger moves Sonic to destination
+    struct Teleport {
+        sf::FloatRect trigger;
+        sf::Vector2f destination;
+    };
+
+    TileLayer background;
+    TileLayer foreground;
+    TileLayer collision;
+    const sf::Texture* playerSheet{nullptr};
+    SpriteArchetypes archetypes;           // every actor and decoration is built from these
+
+    sf::Vector2f playerStart;
+    std::vector<Scenery> scenery;          // flowers, bridges and spike art, baked into the map
+    std::vector<RingGroup> ringGroups;
+    std::vector<sf::Vector2f> rings;
+    std::vector<sf::Vector2f> spikes;
+    std::vector<sf::Vector2f> checkpoints;
+    std::vector<sf::Vector2f> platforms;
+    std::vector<sf::Vector2f> springs;
+    std::vector<sf::Vector2f> buzzers;
+    std::vector<sf::Vector2f> motobugs;
+    std::vector<sf::Vector2f> crabmeats;
+    std::vector<FishSpawn> fish;
+    std::vector<PowerUpSpawn> powerUps;
+    std::vector<Teleport> teleports;
+
+    static void queueAssets(AssetLoader& assets);
+    static std::shared_ptr<const LevelData> load(std::shared_ptr<const AssetLoader> assets);
+
+    const AssetLoader& getAssets() const { return *assets; }
+
+private:
+    void placeScenery();
+    void placeActors();
+
+    std::shared_ptr<const AssetLoader> assets;   // owns the textures the layers point at
+};
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Named counters, gauges and histograms for monitoring. Instruments are
+// registered once at setup and handed out by reference; subsystems then bump
+// them with relaxed atomics from any thread, with no lock and no lookup.
+// exposition() renders everything in the Prometheus text format. Each engine
+// owns one, so engines never share a count
+class Metrics {
+public:
+    // Only ever goes up
+    class Counter {
+    public:
+        void add(uint64_t amount = 1) { value.fetch_add(amount, std::memory_order_relaxed); }
+        uint64_t get() const { return value.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<uint64_t> value{0};
+    };
+
+    // Goes wherever it is set
+    class Gauge {
+    public:
+        void set(int64_t amount) { value.store(amount, std::memory_order_relaxed); }
+        int64_t get() const { return value.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<int64_t> value{0};
+    };
+
+    // Observations counted into fixed buckets by upper bound. The sum is kept in
+    // thousandths so it fits one atomic integer
+    class Histogram {
+    public:
+        explicit Histogram(std::vector<double> upperBounds);
+
+        void observe(double value);
+
+        const std::vector<double>& getBounds() const { return bounds; }
+        uint64_t getBucket(size_t index) const { return buckets[index].load(std::memory_order_relaxed); }
+        uint64_t getCount() const { return count.load(std::memory_order_relaxed); }
+        double getSum() const { return static_cast<double>(sumThousandths.load(std::memory_order_relaxed)) / 1000.0; }
+
+    private:
+        std::vector<double> bounds;                          // ascending; +Inf is implied after the last
+        std::unique_ptr<std::atomic<uint64_t>[]> buckets;    // bounds.size() + 1, not cumulative
+        std::atomic<uint64_t> count{0};
+        std::atomic<int64_t> sumThousandths{0};
+    };
+
+    Metrics() = default;
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+    // Registering a name twice returns the first instrument
+    Counter& counter(const std::string& name, const std::string& help);
+    Gauge& gauge(const std::string& name, const std::string& help);
+    Histogram& histogram(const std::string& name, const std::string& help, std::vector<double> upperBounds);
+
+    std::string exposition() const;
+
+private:
+    struct Entry {
+        std::string name;
+        std::string help;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+    };
+
+    Entry* find(const std::string& name);
+
+    mutable std::mutex mutex;    // guards entries, never the instruments
+    std::vector<Entry> entries;
+};
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef METRICSEXPORTER_H
+#define METRICSEXPORTER_H
+
+#include <SFML/Network.hpp>
+#include <atomic>
+#include <string>
+#include <thread>
+#include "Metrics.h"
+
+// Publishes a registry from a thread of its own: rewrites a file every interval
+// (swapped in whole, so a reader never sees half of it) and/or answers scrapes
+// on a localhost port with the current exposition. Nothing it does is on the
+// simulation or render thread
+class MetricsExporter {
+public:
+    explicit MetricsExporter(const Metrics& metrics) : metrics(metrics) {}
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    // An empty path or a zero port leaves that side off
+    bool start(const std::string& path, unsigned short port, float intervalSeconds = DEFAULT_INTERVAL);
+    void stop();
+
+    static constexpr float DEFAULT_INTERVAL = 5.0f;
+
+private:
+    void run();
+    bool writeFile() const;
+    void serve();
+
+    const Metrics& metrics;
+    std::string filePath;
+    float interval{DEFAULT_INTERVAL};
+    sf::TcpListener listener;
+    bool listening{false};
+    std::thread thread;
+    std::atomic<bool> stopping{false};
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define MOTOBUGENEMY_H
 
 #include "BaseSprite.h"
+#include "EngineContext.h"
 #include "GameMap.h"
 #include "AnimalSprite.h"
 
@@ -14,29 +15,26 @@ private:
     bool movingRight = true;
     bool isActive = true;
     GameMap* collisionMap = nullptr;
-    std::vector<sf::IntRect> smokeFrames;
-    int currentSmokeFrame = 0;
-    float smokeAnimTimer = 0.0f;
-    static constexpr float SMOKE_FRAME_TIME = 0.1f;
+    AnimationPlayer smokeAnimation;
     std::unique_ptr<AnimalSprite> freedAnimal;
 
 
     static constexpr float TURN_PAUSE_DURATION = 0.5f; // Seconds to pause when turning
 
 public:
-    explicit MotobugEnemy(const sf::Vector2f& pos);
+    MotobugEnemy(const SpriteArchetypes& types, const sf::Vector2f& pos);
     ~MotobugEnemy() override = default;
 
     void update(float deltaTime) override;
     void updatePatrolMovement(float deltaTime);
-    void die();
+    void die(const EngineContext& context);
     bool isAlive() const;
     sf::FloatRect getCollisionBounds() const;
     void setCollisionMap(GameMap* map) { collisionMap = map; }
 
     AnimalSprite* getFreedAnimal() const { return freedAnimal.get(); }
 
-    void render(sf::RenderWindow &window) const;
+    void render(RenderSnapshot& target) const;
     void reset();
 };
 
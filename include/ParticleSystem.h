@@ -0,0 +1,83 @@
+#ifndef PARTICLESYSTEM_H
+#define PARTICLESYSTEM_H
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "AnimationClip.h"
+#include "Random.h"
+#include "RenderSnapshot.h"
+
+class SpriteArchetypes;
+
+enum class ParticleEffect {
+    RING_SPARKLE,
+    BADNIK_EXPLOSION,
+    INVINCIBILITY_STARS,
+    SHIELD,
+    COUNT
+};
+
+// What one burst of an effect looks like. Textured emitters spread their clip's
+// frames over the particle's life; untextured ones draw flat squares of `size`
+struct ParticleEmitter {
+    const sf::Texture* texture{nullptr};
+    const AnimationClip* clip{nullptr};
+    int count{1};                   // particles per burst
+    float rate{0.0f};               // particles per second when streamed
+    float lifetime{0.5f};
+    float speedMin{0.0f};
+    float speedMax{0.0f};
+    float angleMin{0.0f};           // launch direction in degrees, 90 points down
+    float angleMax{360.0f};
+    float gravity{0.0f};
+    float spawnRadius{0.0f};
+    bool spawnOnEdge{false};        // spawn on the circle instead of inside it
+    float size{2.0f};
+    sf::Color startColor{sf::Color::White};
+    sf::Color endColor{sf::Color::White};
+
+    static const ParticleEmitter& get(ParticleEffect effect);   // defaults, without textures
+};
+
+// Fixed-capacity pool of short-lived effect particles stored as parallel arrays.
+// Live particles are packed at the front, so the update kernel is a straight
+// loop over floats; drawing is one vertex array per texture
+class ParticleSystem {
+public:
+    static constexpr size_t CAPACITY = 2048;
+
+    ParticleSystem();
+
+    void setArchetypes(const SpriteArchetypes& types);   // textures the level's emitters draw with
+    void emit(ParticleEffect effect, const sf::Vector2f& position);
+    void stream(ParticleEffect effect, const sf::Vector2f& position, float deltaTime);
+    void clear();
+
+    void update(float deltaTime);
+    void render(RenderSnapshot& target);
+
+    size_t size() const { return count; }
+
+private:
+    struct Batch {
+        const sf::Texture* texture{nullptr};
+        sf::VertexArray vertices{sf::PrimitiveType::Triangles};
+    };
+
+    void spawn(uint8_t effect, const ParticleEmitter& emitter, const sf::Vector2f& position);
+    void kill(size_t index);
+    Batch& batchFor(const sf::Texture* texture);
+
+    std::vector<float> posX, posY, velX, velY, gravity, age, lifetime;
+    std::vector<uint8_t> effects;
+    size_t count{0};
+
+    std::array<ParticleEmitter, static_cast<size_t>(ParticleEffect::COUNT)> emitters;
+    std::array<float, static_cast<size_t>(ParticleEffect::COUNT)> streamCarry{};
+    std::vector<Batch> batches;
+    Random random;   // its own, so effects never shift the rolls play depends on
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef PCMCACHE_H
+#define PCMCACHE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include "MappedFile.h"
+
+// Sound effects already decoded into the mixer's format, kept in one binary file
+// next to the assets and mapped read-only on start. An entry is reused while
+// its source file's mtime and size match, or failing that, its content hash
+class PcmCache {
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    explicit PcmCache(std::string path);
+
+    bool find(const std::string& source, const float*& samples, size_t& length);
+    void store(const std::string& source, const float* samples, size_t length);
+
+    // For sources inside the asset pack, whose size and checksum are already known
+    bool find(const std::string& source, uint64_t size, uint64_t hash, const float*& samples, size_t& length);
+    void store(const std::string& source, uint64_t size, uint64_t hash, const float* samples, size_t length);
+
+    // Swaps the cache file for a fresh one. Samples handed out before it point
+    // into the old mapping and have to be looked up again, whether or not the
+    // swap worked. On failure every entry is kept and the cache stays dirty
+    bool save();
+    bool isDirty() const { return dirty; }
+    bool lookup(const std::string& source, const float*& samples, size_t& length) const;
+
+private:
+    struct Stamp {
+        int64_t mtime{0};
+        uint64_t size{0};
+        uint64_t hash{0};
+    };
+
+    // samples point into the mapping or at a clip the caller keeps alive
+    struct Entry {
+        Stamp stamp;
+        const float* samples{nullptr};
+        size_t length{0};
+        bool mapped{false};
+    };
+
+    bool load();
+    static bool readStamp(const std::string& source, Stamp& stamp);
+    static uint64_t hashFile(const std::string& source);
+
+    std::string path;
+    MappedFile file;
+    std::unordered_map<std::string, Entry> entries;
+    bool dirty{false};
+};
+
+#endif
@@ -5,16 +5,11 @@
 
 class PlatformSprite final : public BaseSprite {
 public:
-    explicit PlatformSprite(const sf::Vector2f& pos);
+    PlatformSprite(const SpriteArchetypes& types, const sf::Vector2f& pos);
     ~PlatformSprite() override = default;
 
     static void createPlatformGroup(std::vector<PlatformSprite*>& platforms,
-                                    const std::vector<sf::Vector2f>& positions);
-
-private:
-    void initializeFrames() override;
-    static constexpr sf::Vector2i SPRITE_POS{220, 25};
-    static constexpr sf::Vector2i SPRITE_SIZE{60, 27};
+                                    const std::vector<sf::Vector2f>& positions, const SpriteArchetypes& types);
 };
 
 #endif
\ No newline at end of file
@@ -2,12 +2,18 @@
 #define PLAYER_H
 
 #include <SFML/Graphics.hpp>
+#include <array>
 #include <cmath>
 #include <iostream>
+#include "AnimationClip.h"
 #include "GameMap.h"
 #include "GameEngine.h"
 #include "GameState.h"
+#include "LevelData.h"
+#include "PlayerInput.h"
+#include "EngineContext.h"
 #include "SpikeSprite.h"
+#include "StateHash.h"
 #include "../include/FishEnemy.h"
 
 // Forward declarations
@@ -40,7 +46,7 @@ T move_toward(T current, T target, T maxDelta) {
 class Player final {
 public:
     // Constructor/Destructor
-    Player();
+    Player(const sf::Texture& sheet, const EngineContext& context);
     ~Player();
 
     void startSpeedBoost(float duration) {
@@ -73,37 +79,14 @@ public:
 
     bool checkTeleportArea() {
 
-        if (isHurt || isDead) {
+        if (isHurt || isDead || !context.level) {
             return false;
         }
 
-
-        struct TeleportZone {
-            sf::FloatRect triggerBox;
-            sf::Vector2f destination;
-        };
-
-        std::vector<TeleportZone> teleportZones = {
-
-                {
-                        sf::FloatRect(sf::Vector2f(6613.0f, 346.0f), sf::Vector2f(40.0f, 60.0f)),
-                        sf::Vector2f(6993.0f, 1118.0f)
-                },
-                {
-                        sf::FloatRect(sf::Vector2f(6612.0f, 852.0f), sf::Vector2f(40.0f, 60.0f)),
-                        sf::Vector2f(6993.0f, 1118.0f)
-                },
-                {
-                        sf::FloatRect(sf::Vector2f(6102.0f, 579.0f), sf::Vector2f(40.0f, 60.0f)),
-                        sf::Vector2f(6413.79f, 850.5f)
-
-                }
-        };
-
         sf::FloatRect playerBounds = getCollisionBounds();
 
-        for (const auto& zone : teleportZones) {
-            if (zone.triggerBox.findIntersection(playerBounds)) {
+        for (const auto& zone : context.level->teleports) {
+            if (zone.trigger.findIntersection(playerBounds)) {
 
                 setPosition(zone.destination);
 
@@ -114,9 +97,7 @@ public:
                 isOnGround = false;
                 isSkidding = false;
                 controlLock = false;
-                animState = IDLE;
-                frame = sf::IntRect({27, 39}, {32, 40});
-                sprite.setTextureRect(frame);
+                enterAnimationState(IDLE);
 
                 return true;
             }
@@ -126,8 +107,8 @@ public:
     }
 
 
-    void update();
-    void render(sf::RenderWindow& window) const;
+    void update(float deltaTime);
+    void render(RenderSnapshot& target) const;
     void resetGame();
 
     bool wasHurt = false;
@@ -143,6 +124,8 @@ public:
     bool getAnimationSwitch();
     sf::Vector2f getPosition() const;
     sf::FloatRect getCollisionBounds() const;
+    void hashState(StateHasher& hasher) const;
+    void hashTimers(StateHasher& hasher) const;
     bool isHighWall() const;
 
 
@@ -151,6 +134,7 @@ public:
     void setPosition(float x, float y);
     void setPosition(const sf::Vector2f& pos) { setPosition(pos.x, pos.y); }
     void setEngineRef(GameEngine* engine) { engineRef = engine; }
+    void setInput(const PlayerInput& held) { input = held; }
 
 
     int getRingCount() const { return ringCount; }
@@ -170,6 +154,8 @@ public:
 
     void handleDamage();
     bool IsInvincible() const { return isInvincible; }
+    bool HasInvincibilityPowerUp() const { return invincibilityTimer > 0; }
+    bool HasShield() const { return hasShield; }
     bool isInvincible = false;
 
     sf::Vector2f velocity;
@@ -178,32 +164,6 @@ public:
 
 private:
 
-    sf::SoundBuffer ringLossBuffer;
-    sf::SoundBuffer deathBuffer;
-    std::unique_ptr<sf::Sound> ringLossSound;
-    std::unique_ptr<sf::Sound> deathSound;
-    bool soundsLoaded = false;
-
-    void initSounds() {
-
-        if (!soundsLoaded) {
-            if (ringLossBuffer.loadFromFile("./assets/ring-loss.mp3")) {
-                ringLossSound = std::make_unique<sf::Sound>(ringLossBuffer);
-            } else {
-                std::cerr << "Failed to load ring loss sound" << std::endl;
-            }
-
-            if (deathBuffer.loadFromFile("./assets/death.mp3")) {
-                deathSound = std::make_unique<sf::Sound>(deathBuffer);
-            } else {
-                std::cerr << "Failed to load death sound" << std::endl;
-            }
-
-            soundsLoaded = true;
-        }
-    }
-
-
     float currentMaxSpeed = TOP_SPEED;
 
     static constexpr float ACCELERATION_SPEED = 0.046875f;
@@ -219,6 +179,7 @@ private:
     static constexpr float HURT_GRAVITY = 0.5f;
     static constexpr float HURT_DURATION = 1.0f;
     static constexpr float INVINCIBILITY_DURATION = 2.0f;
+    static constexpr float HURT_FLASH_FREQUENCY = 15.0f;
 
 
 
@@ -253,20 +214,20 @@ private:
     // Game state
     int ringCount = 0;
     short animState = IDLE;
+    short previousAnimState = IDLE;
 
     // SFML objects
-    sf::Texture texture;
     sf::Sprite sprite;
-    sf::IntRect frame;
-    sf::Clock timer;
-    sf::Clock idleClock;
-    sf::Clock debugTimer;
-    sf::Clock hurtClock;
-    sf::Clock airTimer;
+    AnimationPlayer animation;
+    std::array<const AnimationClip*, PIPE_SLIDING + 1> stateClips{};
+    PlayerInput input;
+    float idleTime = 0.0f;   // seconds spent idle, for the bored animation
+    float hurtTime = 0.0f;   // seconds since the last hit, for the hurt and flash timers
 
 
     GameMap* collisionMap = nullptr;
     GameEngine* engineRef = nullptr;
+    const EngineContext& context;
 
 
     void initPlayer();
@@ -274,7 +235,8 @@ private:
     void initAnimation();
 
     void updateMovement();
-    void updateAnimation();
+    void updateAnimation(float deltaTime);
+    void enterAnimationState(short state);
     void updatePhysics();
     void updateHurtState();
     void enterHurtState();
@@ -0,0 +1,14 @@
+#ifndef PLAYERINPUT_H
+#define PLAYERINPUT_H
+
+// The buttons held this step. The windowed engine reads them off the keyboard;
+// a headless one takes them from whoever drives it
+struct PlayerInput {
+    bool left{false};
+    bool right{false};
+    bool up{false};
+    bool down{false};
+    bool jump{false};
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define POWERUPSPRITE_H
 
 #include "BaseSprite.h"
+#include <optional>
 
 
 class GameEngine;
@@ -17,7 +18,7 @@ public:
         HEALTH
     };
 
-    PowerUpSprite(const sf::Vector2f& pos, PowerUpType powerupType);
+    PowerUpSprite(const SpriteArchetypes& types, const sf::Vector2f& pos, PowerUpType powerupType);
     ~PowerUpSprite() override = default;
 
 
@@ -26,7 +27,7 @@ public:
 
 
     sf::FloatRect getCollisionBounds() const;
-    void render(sf::RenderWindow& window) override;
+    void render(RenderSnapshot& target) override;
 
     void setEngineRef(GameEngine* engine) { engineRef = engine; }
 
@@ -34,6 +35,8 @@ private:
     void initializeFrames() override;
     PowerUpType type;
     bool broken{false};
+    sf::IntRect boxFrame;
+    std::optional<sf::IntRect> iconFrame;
 
     GameEngine* engineRef{nullptr};
 };
@@ -0,0 +1,46 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+// A small seeded generator (xorshift64*) in place of std::rand. Each engine owns
+// its own, so the same seed gives the same rolls whichever thread steps it, and
+// its state is a single word that can be hashed and checked on replay
+class Random {
+public:
+    static constexpr uint64_t DEFAULT_SEED = 0x5EED;
+
+    explicit Random(uint64_t seed = DEFAULT_SEED) { reseed(seed); }
+
+    // splitmix64 spreads nearby seeds apart; a zero state would never move
+    void reseed(uint64_t seed) {
+        uint64_t z = seed + 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        state = (z ^ (z >> 31)) | 1u;
+    }
+
+    uint32_t next() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return static_cast<uint32_t>((state * 0x2545F4914F6CDD1Dull) >> 32);
+    }
+
+    // 0 .. bound - 1
+    int below(int bound) {
+        return bound > 0 ? static_cast<int>(next() % static_cast<uint32_t>(bound)) : 0;
+    }
+
+    // min .. max, never quite reaching max
+    float range(float min, float max) {
+        return min + (max - min) * static_cast<float>(next() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    uint64_t getState() const { return state; }
+
+private:
+    uint64_t state{1};
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef RENDERPIPELINE_H
+#define RENDERPIPELINE_H
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "RenderSnapshot.h"
+
+// Three snapshots handed from the simulation to the renderer. The simulation
+// fills back() and publishes it; the renderer takes the newest published one as
+// front(). Only the middle slot changes hands under the lock, so recording and
+// drawing never touch the same snapshot.
+// Without a render thread the engine draws front() itself after each update.
+// With one, the simulation of the next frame overlaps the drawing (and the
+// vsync wait) of the current one, and publish() holds the simulation back when
+// it gets a whole frame ahead, so it still steps once per displayed frame
+class RenderPipeline {
+public:
+    using DrawFunction = std::function<void(const RenderSnapshot&)>;
+
+    RenderPipeline() = default;
+    ~RenderPipeline();
+
+    RenderPipeline(const RenderPipeline&) = delete;
+    RenderPipeline& operator=(const RenderPipeline&) = delete;
+
+    void start(sf::RenderWindow& window, DrawFunction draw);
+    void stop();
+    bool isThreaded() const { return thread.joinable(); }
+
+    RenderSnapshot& back() { return slots[backIndex]; }
+    void publish();
+
+    bool acquire();
+    const RenderSnapshot& front() const { return slots[frontIndex]; }
+
+private:
+    void renderLoop(sf::RenderWindow& window, DrawFunction draw);
+
+    std::array<RenderSnapshot, 3> slots;
+    size_t backIndex{0};
+    size_t readyIndex{1};
+    size_t frontIndex{2};
+    bool fresh{false};       // readyIndex holds a snapshot nobody has drawn yet
+    bool stopping{false};
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::thread thread;
+    std::exception_ptr error;
+};
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef RENDERSNAPSHOT_H
+#define RENDERSNAPSHOT_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "GameState.h"
+#include "PlayerInput.h"
+
+// Values the intro, pause menu and end screens are drawn from. The simulation
+// copies them into each frame's snapshot; drawing never reads the live ones
+struct OverlayState {
+    float introAlpha{255.0f};
+    float loadProgress{0.0f};
+    float completionAlpha{0.0f};
+    float musicVolume{50.0f};
+    bool musicMuted{false};
+    bool godMode{false};
+    bool gridMapVisible{false};
+    bool pixelPerfect{false};
+    bool frameGraphVisible{false};
+};
+
+// What one frame cost, for the frame graph. The simulation fills in its side;
+// the render side adds its own time and draw calls
+struct FrameStats {
+    float pollMs{0.0f};
+    float updateMs{0.0f};
+    float renderMs{0.0f};
+    size_t drawCalls{0};
+    size_t entitiesTicked{0};
+    size_t collisionQueries{0};
+    size_t allocations{0};
+    PlayerInput input;          // the buttons the step ran on
+};
+
+// One frame as the simulation left it: the game state, the HUD and menu values,
+// and a copy of every visible quad grouped into batches by view, texture and
+// primitive. World code records into it with the same calls it would make on a
+// render target; replay() then draws it, on whichever thread renders. Vectors
+// keep their capacity between frames, so recording does not allocate once warm.
+// Large arrays that never change once built are held by reference instead of
+// copied; the snapshot keeps them alive until it is cleared
+class RenderSnapshot {
+public:
+    struct HudValues {
+        int score{0};
+        float time{0.0f};
+        int rings{0};
+        int lives{0};
+    };
+
+    GameState state{GameState::INTRO};
+    bool paused{false};
+    bool pixelPerfect{false};
+    uint32_t worldRevision{0};   // bumped when a menu option changes how the world looks
+    HudValues hud;
+    OverlayState overlay;
+    FrameStats stats;
+
+    void clear();
+
+    void setView(const sf::View& view);
+    const sf::View& getView() const { return views.back(); }
+
+    void draw(const sf::Sprite& sprite);
+    void draw(const sf::VertexArray& vertices, const sf::RenderStates& states = sf::RenderStates::Default);
+    void draw(const sf::Vertex* source, size_t count, sf::PrimitiveType primitive,
+              const sf::RenderStates& states = sf::RenderStates::Default);
+    void draw(std::shared_ptr<const sf::VertexArray> shared,
+              const sf::RenderStates& states = sf::RenderStates::Default);
+
+    void replay(sf::RenderTarget& target) const;
+    bool hasWorld() const { return !batches.empty(); }
+    size_t getBatchCount() const { return batches.size(); }
+    size_t getVertexCount() const { return vertices.size(); }
+
+private:
+    struct Batch {
+        size_t view;
+        const sf::Texture* texture;
+        sf::PrimitiveType primitive;
+        size_t first;
+        size_t count;
+        std::shared_ptr<const sf::VertexArray> shared;    // drawn in place of first / count
+        sf::Transform transform;                          // only for shared; copies are pre-transformed
+    };
+
+    Batch& batchFor(const sf::Texture* texture, sf::PrimitiveType primitive);
+
+    std::vector<sf::View> views{sf::View()};
+    std::vector<sf::Vertex> vertices;
+    std::vector<Batch> batches;
+};
+
+#endif
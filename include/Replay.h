@@ -0,0 +1,41 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "PlayerInput.h"
+#include "Random.h"
+#include "StateHash.h"
+
+// A recorded run: the seed, and the buttons and time step of every step taken.
+// The state hash after each step goes to a sidecar next to it (path + ".hash"),
+// so a run can be played back on another build and checked step by step. The
+// sidecar is optional; a replay without one still plays, it just checks nothing
+class Replay {
+public:
+    struct Frame {
+        PlayerInput input;
+        float deltaTime{0.0f};
+        bool reset{false};     // the game was restarted just before this step
+        bool godMode{false};
+    };
+
+    // First step whose hash disagrees, and the first part that does
+    struct Divergence {
+        size_t frame;
+        HashPart part;
+    };
+
+    uint64_t seed{Random::DEFAULT_SEED};
+    std::vector<Frame> frames;
+    std::vector<StateHash> hashes;
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+    static std::string sidecarPath(const std::string& path) { return path + ".hash"; }
+};
+
+#endif
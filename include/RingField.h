@@ -0,0 +1,49 @@
+#ifndef RINGFIELD_H
+#define RINGFIELD_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "AnimationClip.h"
+#include "SpriteArchetype.h"
+#include "ParticleSystem.h"
+#include "EngineContext.h"
+
+// All placed (non-scattered) rings of a level. Positions are kept sorted by x with
+// a collected bitset next to them, every idle ring shares one spin clip, and the
+// visible ones are drawn with a single vertex array. Pick-up sparkles are handed
+// to the particle system
+class RingField {
+public:
+    static constexpr float GROUP_SPACING = 6 * 4;
+
+    void addRing(const sf::Vector2f& pos);
+    void addRingGroup(float startX, float startY, int count);
+    void clear();
+    void setParticles(ParticleSystem* system) { particles = system; }
+    void setArchetype(const SpriteArchetype& type);
+
+    int collect(const sf::FloatRect& bounds, const EngineContext& context);
+    void reset();
+
+    void update(float deltaTime);
+    void render(RenderSnapshot& target);
+
+    size_t size() const { return positions.size(); }
+    bool isCollected(size_t index) const { return (collected[index / 64] >> (index % 64)) & 1u; }
+    const std::vector<uint64_t>& getCollectedBits() const { return collected; }
+
+private:
+    void setCollected(size_t index);
+    void appendQuad(const sf::Vector2f& pos, const sf::IntRect& rect);
+
+    const SpriteArchetype* archetype{nullptr};
+    std::vector<sf::Vector2f> positions;
+    std::vector<uint64_t> collected;
+    AnimationPlayer spin;
+    ParticleSystem* particles{nullptr};
+    sf::VertexArray vertices{sf::PrimitiveType::Triangles};
+
+};
+
+#endif
@@ -2,17 +2,18 @@
 #define RINGSPRITE_H
 
 #include "BaseSprite.h"
+#include "EngineContext.h"
 
 class RingSprite final : public BaseSprite {
 public:
-    explicit RingSprite(const sf::Vector2f& pos);
+    RingSprite(const SpriteArchetypes& types, const sf::Vector2f& pos);
     ~RingSprite() override = default;
 
 
     void update(float deltaTime) override;
 
 
-    void collect();
+    void collect(const EngineContext& context);
     bool isActive() const { return !isCollectAnimationDone; }
     bool isCollected() const { return m_isCollected; }
 
@@ -27,9 +28,6 @@ public:
     sf::FloatRect getBounds() const { return sprite.getGlobalBounds(); }
 
 
-    static void createRingGroup(std::vector<RingSprite*>& sprites,
-                                float startX, float startY,
-                                int count);
 
 
 
@@ -37,9 +35,7 @@ public:
     void uncollect() {
         m_isCollected = false;
         isCollectAnimationDone = false;
-        collectFrameIndex = 0;
-        animationTimer = 0.0f;
-        sprite.setTextureRect(frames[0]);  // Reset to initial frame
+        initializeFrames();                // Back to the spin clip
         sprite.setColor(sf::Color::White); // Reset any color changes
     }
 
@@ -47,11 +43,8 @@ public:
 private:
 
     void initializeFrames() override;
-    void initializeCollectFrames();
     bool m_isCollected{false};
     bool isCollectAnimationDone{false};
-    std::vector<sf::IntRect> collectFrames;
-    int collectFrameIndex{0};
 };
 
 
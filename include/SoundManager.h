@@ -2,37 +2,79 @@
 #define SOUNDMANAGER_H
 
 #include <SFML/Audio.hpp>
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
+#include "AudioMixer.h"
+#include "Metrics.h"
+#include "PcmCache.h"
+
+// Index of a loaded sound, resolved once at load time so playing never hashes a name
+using SoundId = int;
+constexpr SoundId NO_SOUND = -1;
+
+// The effects game code asks for; each engine maps them to its own SoundIds
+enum class SoundEffect {
+    NONE,
+    JUMP,
+    BUMPER,
+    RING_COLLECT,
+    BADNIK_DEATH,
+    RING_LOSS,
+    DEATH,
+    COUNT
+};
 
 class SoundManager {
 private:
-    static SoundManager* instance;
-    std::unordered_map<std::string, std::unique_ptr<sf::SoundBuffer>> buffers;
-    std::unordered_map<std::string, std::unique_ptr<sf::Sound>> sounds;
+    // A decoded effect plus how often it may restart
+    struct SoundEntry {
+        std::string name;
+        std::string source;
+        PcmClip clip;
+        float cooldown{0.0f};
+        float lastPlayed{-1.0f};
+    };
+
+    std::vector<std::unique_ptr<SoundEntry>> entries;
+    std::unordered_map<std::string, SoundId> ids;
+    PcmCache cache{"./assets/sounds.pcmcache"};
+    AudioMixer mixer;
+    sf::Clock clock;
     float volume = 30.0f;
+    Metrics::Counter* playCounter = nullptr;
 
-    SoundManager() = default;
+    SoundId addEntry(const std::string& name, const std::string& source, PcmClip&& clip);
+    static PcmClip decode(sf::InputSoundFile& file);
 
 public:
-    static SoundManager& getInstance();
-    void loadSound(const std::string& name, const std::string& filepath);
-    void playSound(const std::string& name);
+    SoundManager();
+
+    SoundManager(const SoundManager&) = delete;
+    SoundManager& operator=(const SoundManager&) = delete;
+
+    static PcmClip decode(const std::string& filepath);
+    static PcmClip decode(const void* data, size_t size);
+
+    SoundId loadSound(const std::string& name, const std::string& filepath, int priority = 0, float cooldown = 0.0f);
+    SoundId loadCached(const std::string& name, const std::string& filepath);
+    SoundId addSound(const std::string& name, const std::string& filepath, PcmClip&& clip);
+    SoundId find(const std::string& name) const;
+    void playSound(SoundId id);
+    void setPlayCounter(Metrics::Counter* counter) { playCounter = counter; }
+    void stopAll() { mixer.stopAll(); }
+    bool saveCache();
 
 
 
     void setVolume(float newVolume) {
         volume = std::clamp(newVolume, 0.0f, 100.0f);
-
-        for (auto& [name, sound] : sounds) {
-            if (sound) {
-                sound->setVolume(volume);
-            }
-        }
+        mixer.setVolume(volume);
     }
 
     float getVolume() const { return volume; }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -4,16 +4,12 @@
 #include "BaseSprite.h"
 
 class SpikeSprite final : public BaseSprite {
-private:
-    void initializeFrames() override;
-
-
 public:
-    explicit SpikeSprite(const sf::Vector2f& pos);
+    SpikeSprite(const SpriteArchetypes& types, const sf::Vector2f& pos);
     ~SpikeSprite() override = default;
 
     sf::FloatRect getCollisionBounds() const;
-    static void createSpikeGroup(std::vector<SpikeSprite*>& sprites, const std::vector<sf::Vector2f>& positions);
+    static void createSpikeGroup(std::vector<SpikeSprite*>& sprites, const std::vector<sf::Vector2f>& positions, const SpriteArchetypes& types);
 };
 
 #endif
\ No newline at end of file
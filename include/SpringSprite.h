@@ -11,7 +11,7 @@ public:
     static constexpr float VERTICAL_HEIGHT = 17.0f;
     static constexpr float PULL_DISTANCE = 8.0f;
 
-    explicit SpringSprite(const sf::Vector2f& pos);
+    SpringSprite(const SpriteArchetypes& types, const sf::Vector2f& pos);
     ~SpringSprite() override = default;
 
     void update(float deltaTime) override;
@@ -29,22 +29,20 @@ public:
     }
 
     static void createSpringGroup(std::vector<SpringSprite*>& springs,
-                                  const std::vector<sf::Vector2f>& positions);
+                                  const std::vector<sf::Vector2f>& positions, const SpriteArchetypes& types);
 
 private:
-    void initializeFrames() override;
-
     static constexpr float EXTENSION_DURATION = 0.3f;
     static constexpr sf::Vector2i NORMAL_FRAME_POS{554, 313};
     static constexpr sf::Vector2i NORMAL_FRAME_SIZE{32, 16};
     static constexpr sf::Vector2i EXTENDED_FRAME_POS{554, 337};
     static constexpr sf::Vector2i EXTENDED_FRAME_SIZE{32, 32};
+    static constexpr sf::IntRect NORMAL_FRAME{NORMAL_FRAME_POS, NORMAL_FRAME_SIZE};
+    static constexpr sf::IntRect EXTENDED_FRAME{EXTENDED_FRAME_POS, EXTENDED_FRAME_SIZE};
 
     bool m_extended{false};
     bool m_canBounce{true};
     float m_extensionTimer{0.0f};
-    sf::IntRect m_normalFrame;
-    sf::IntRect m_extendedFrame;
 };
 
 #endif
\ No newline at end of file
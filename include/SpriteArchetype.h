@@ -0,0 +1,55 @@
+#ifndef SPRITEARCHETYPE_H
+#define SPRITEARCHETYPE_H
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include "AnimationClip.h"
+#include "SoundManager.h"
+
+enum class SpriteKind {
+    RING,
+    CHECKPOINT,
+    SPIKE,
+    BRIDGE,
+    PLATFORM,
+    SPRING,
+    POWERUP,
+    ANIMAL,
+    BUZZER,
+    MOTOBUG,
+    CRABMEAT,
+    FISH,
+    FLOWER_TALL,
+    FLOWER_SHORT,
+    COUNT
+};
+
+class AssetLoader;
+
+// Everything that is the same for every instance of a sprite type. Built once per
+// level and shared by reference, so an instance only carries its mutable state
+struct SpriteArchetype {
+    SpriteKind kind{SpriteKind::COUNT};
+    const sf::Texture* texture{nullptr};
+    const AnimationClip* clip{nullptr};       // clip a fresh instance starts on
+    const AnimationClip* actionClip{nullptr}; // collect / shoot / attack / smoke, if the type has one
+    sf::IntRect projectileFrame;
+    float hitboxInset{0.0f};                  // shrinks the collision box on every side
+    SoundEffect sound{SoundEffect::NONE};     // played on collect / death
+    bool animated{false};
+};
+
+// One archetype per kind, pointing at the sheets of the loader it was resolved
+// against. Lives in LevelData next to that loader, so no archetype outlives its textures
+class SpriteArchetypes {
+public:
+    void resolve(const AssetLoader& assets);   // throws if a sheet was not loaded
+    const SpriteArchetype& get(SpriteKind kind) const { return types[static_cast<size_t>(kind)]; }
+
+private:
+    SpriteArchetype& at(SpriteKind kind);
+
+    std::array<SpriteArchetype, static_cast<size_t>(SpriteKind::COUNT)> types;
+};
+
+#endif
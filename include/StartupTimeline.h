@@ -0,0 +1,65 @@
+#ifndef STARTUPTIMELINE_H
+#define STARTUPTIMELINE_H
+
+#include <SFML/System.hpp>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Where cold start goes. Main-thread work is timed as nested scopes (engine and
+// menu constructors, map building, sound loads); the asset loader adds each
+// file's read and decode from its workers and each texture's upload, with the
+// bytes involved. Times are milliseconds since the timeline was made, which
+// main does first. Spans are added on the main thread only: workers read now()
+// and hand their numbers back with their results
+class StartupTimeline {
+public:
+    enum class Kind {
+        CPU,       // main-thread scope
+        IO,        // file bytes read by a loader worker
+        DECODE,    // image, table or sound decoded by a loader worker
+        UPLOAD,    // texture handed to the GPU
+        MARK       // a milestone such as the first frame
+    };
+
+    struct Span {
+        std::string name;
+        Kind kind;
+        int depth;              // scope nesting; loader work sits at the depth it was finished at
+        double startMs;
+        double durationMs;
+        size_t bytes;
+    };
+
+    // Times the enclosing block as a span under whatever scope is open. Does
+    // nothing without a timeline, so engines built without one pay nothing
+    class Scope {
+    public:
+        Scope(StartupTimeline* timeline, const char* name);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        StartupTimeline* timeline;
+        size_t index{0};
+    };
+
+    double now() const { return clock.getElapsedTime().asMicroseconds() / 1000.0; }   // any thread
+
+    void add(const std::string& name, Kind kind, double startMs, double durationMs, size_t bytes = 0);
+    void mark(const std::string& name);        // once per name; later calls are ignored
+    double getMark(const std::string& name) const;   // negative if not reached
+
+    // The spans in start order, then totals per kind and the milestones
+    void report(std::ostream& out) const;
+
+private:
+    std::vector<Span> spans;
+    int depth{0};
+    sf::Clock clock;
+};
+
+#endif
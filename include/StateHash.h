@@ -0,0 +1,47 @@
+#ifndef STATEHASH_H
+#define STATEHASH_H
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// The parts of the simulation hashed separately, so a mismatch can say where
+enum class HashPart {
+    PLAYER,
+    BADNIKS,
+    RINGS,
+    RANDOM,
+    TIMERS,
+    COUNT
+};
+
+const char* hashPartName(HashPart part);
+
+// FNV-1a over the exact bytes fed to it. Floats go in by bit pattern, so two
+// runs only hash alike when they agree to the last bit
+class StateHasher {
+public:
+    void add(const void* data, size_t size);
+    void add(float value) { add(&value, sizeof(value)); }
+    void add(int value) { add(&value, sizeof(value)); }
+    void add(uint64_t value) { add(&value, sizeof(value)); }
+    void add(bool value) { add(static_cast<int>(value)); }
+    void add(const sf::Vector2f& value) { add(value.x); add(value.y); }
+
+    uint64_t value() const { return hash; }
+
+private:
+    uint64_t hash{14695981039346656037ull};
+};
+
+// One step's worth of hashes, one per part
+struct StateHash {
+    std::array<uint64_t, static_cast<size_t>(HashPart::COUNT)> parts{};
+
+    uint64_t& operator[](HashPart part) { return parts[static_cast<size_t>(part)]; }
+    uint64_t operator[](HashPart part) const { return parts[static_cast<size_t>(part)]; }
+    uint64_t combined() const;
+};
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef WORLDRENDERTARGET_H
+#define WORLDRENDERTARGET_H
+
+#include <SFML/Graphics.hpp>
+
+// Offscreen target the world is drawn into before it reaches the screen (the
+// window, or the frozen frame captured for menus).
+// In pixel perfect mode it is the native logical resolution, blitted with the
+// largest integer scale that fits, nearest-neighbour filtered and letterboxed.
+// Otherwise it is the screen size times the render scale, stretched back to the
+// screen; at scale 1 the world goes straight into the screen. The HUD is always
+// drawn on top at full resolution
+class WorldRenderTarget {
+public:
+    explicit WorldRenderTarget(const sf::Vector2u& nativeSize);
+
+    void setPixelPerfect(bool value) { pixelPerfect = value; }
+    void setRenderScale(float value) { renderScale = value; }
+
+    sf::RenderTarget& begin(sf::RenderTarget& screen);
+    void present(sf::RenderTarget& screen);
+
+    bool isActive() const { return active; }
+    const sf::Vector2u& getNativeSize() const { return nativeSize; }
+    sf::Vector2u getSize() const { return texture.getSize(); }
+
+private:
+    bool ensureSize(const sf::Vector2u& size);
+
+    sf::Vector2u nativeSize;
+    sf::RenderTexture texture;
+    bool pixelPerfect{false};
+    float renderScale{1.0f};
+    bool failed{false};
+    bool active{false};
+};
+
+#endif
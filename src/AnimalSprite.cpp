@@ -1,26 +1,12 @@
 #include "AnimalSprite.h"
-#include <iostream>
 #include <cmath>
 
 
-AnimalSprite::AnimalSprite(const sf::Vector2f& pos, bool moveRight) : BaseSprite(pos, true) {
-    if (!texture.loadFromFile("./assets/animals_fixed.png")) {
-        std::cerr << "fail" << std::endl;
-        return;
-    }
-
-    sprite.setTexture(texture);
-    initializeFrames();
-    sprite.setTextureRect(frames[0]);
-    sprite.setPosition(position);
+AnimalSprite::AnimalSprite(const SpriteArchetypes& types, const sf::Vector2f& pos, bool moveRight)
+        : BaseSprite(types.get(SpriteKind::ANIMAL), pos) {
     velocityX = moveRight ? 50.0f : -50.0f;
 }
 
-
-void AnimalSprite::initializeFrames() {
-    frames.emplace_back(sf::IntRect(sf::Vector2i(17, 81), sf::Vector2i(16, 24)));
-}
-
 //updates the animal sprite
 void AnimalSprite::update(float deltaTime) {
 
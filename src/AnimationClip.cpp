@@ -0,0 +1,153 @@
+#include "../include/AnimationClip.h"
+#include "../include/AssetPack.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    constexpr float MIN_FRAME_DURATION = 0.001f;
+
+    std::vector<std::string> splitRow(const std::string& line) {
+        std::vector<std::string> cells;
+        std::istringstream stream(line);
+        std::string cell;
+        while (std::getline(stream, cell, ',')) {
+            while (!cell.empty() && (cell.back() == '\r' || cell.back() == ' ')) cell.pop_back();
+            while (!cell.empty() && cell.front() == ' ') cell.erase(cell.begin());
+            cells.push_back(cell);
+        }
+        return cells;
+    }
+}
+
+const AnimationLibrary& AnimationLibrary::shared() {
+    static const AnimationLibrary library = [] {
+        AnimationLibrary loaded;
+        if (!loaded.loadFromFile("./assets/animations.csv")) {
+            throw std::runtime_error("fail ./assets/animations.csv");
+        }
+        return loaded;
+    }();
+    return library;
+}
+
+// Reads the clip table from the mounted pack, or the loose file without one
+bool AnimationLibrary::loadFromFile(const std::string& path) {
+    bool found = false;
+    const bool loaded = AssetPack::read(path, [&](std::istream& in) {
+        found = true;
+        return load(in, path);
+    });
+    if (!found) {
+        std::cerr << "fail " << path << std::endl;
+    }
+    return loaded;
+}
+
+// A "clip" row opens a clip, the "frame" rows after it append frames to it;
+// the hitbox columns are optional and default to the whole frame
+bool AnimationLibrary::load(std::istream& file, const std::string& path) {
+    AnimationClip* clip = nullptr;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        auto cells = splitRow(line);
+        if (cells.empty() || cells[0].empty() || cells[0][0] == '#') continue;
+
+        try {
+            if (cells[0] == "clip" && cells.size() >= 3) {
+                clip = &clips[cells[1]];
+                clip->name = cells[1];
+                clip->loopStart = std::stoi(cells[2]);
+                clip->frames.clear();
+            }
+            else if (cells[0] == "frame" && cells.size() >= 6 && clip) {
+                AnimationFrame frame;
+                frame.rect = sf::IntRect({std::stoi(cells[1]), std::stoi(cells[2])},
+                                         {std::stoi(cells[3]), std::stoi(cells[4])});
+                frame.duration = std::max(MIN_FRAME_DURATION, std::stof(cells[5]));
+                frame.hitbox = sf::IntRect({0, 0}, frame.rect.size);
+                if (cells.size() >= 10) {
+                    frame.hitbox = sf::IntRect({std::stoi(cells[6]), std::stoi(cells[7])},
+                                               {std::stoi(cells[8]), std::stoi(cells[9])});
+                }
+                clip->frames.push_back(frame);
+            }
+            else {
+                std::cerr << "fail " << path << ":" << lineNumber << std::endl;
+            }
+        } catch (...) {
+            std::cerr << "fail " << path << ":" << lineNumber << std::endl;
+        }
+    }
+
+    for (auto& [name, loaded] : clips) {
+        if (loaded.frames.empty()) {
+            std::cerr << "fail empty clip " << name << std::endl;
+            return false;
+        }
+        if (loaded.loopStart >= static_cast<int>(loaded.frames.size())) {
+            loaded.loopStart = 0;
+        }
+    }
+    return true;
+}
+
+const AnimationClip& AnimationLibrary::get(const std::string& name) const {
+    auto it = clips.find(name);
+    if (it == clips.end()) {
+        throw std::runtime_error("fail clip " + name);
+    }
+    return it->second;
+}
+
+
+// Switches to a clip, returns true when the shown frame may have changed
+bool AnimationPlayer::play(const AnimationClip& clip, bool restartClip) {
+    if (current == &clip && !restartClip) {
+        return false;
+    }
+    current = &clip;
+    restart();
+    return true;
+}
+
+void AnimationPlayer::restart() {
+    index = 0;
+    elapsed = 0.0f;
+    finished = false;
+}
+
+// Moves the playhead by deltaTime, carrying the leftover time into the next
+// frame so playback stays exact at any frame rate. Returns true when the frame changed
+bool AnimationPlayer::advance(float deltaTime) {
+    if (!current || paused || finished) {
+        return false;
+    }
+
+    const auto& frames = current->frames;
+    if (frames.size() == 1 && current->loops()) {
+        return false;
+    }
+
+    elapsed += deltaTime;
+    bool changed = false;
+    while (elapsed >= frames[index].duration) {
+        elapsed -= frames[index].duration;
+
+        if (index + 1 < frames.size()) {
+            ++index;
+        } else if (current->loops()) {
+            index = static_cast<size_t>(current->loopStart);
+        } else {
+            finished = true;
+            elapsed = 0.0f;
+            break;
+        }
+        changed = true;
+    }
+    return changed;
+}
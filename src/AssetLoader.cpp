@@ -0,0 +1,260 @@
+#include "../include/AssetLoader.h"
+#include "../include/SoundManager.h"
+#include "../include/AssetPack.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+
+namespace {
+    // A file's bytes: a view into the pack when it holds them, else the whole
+    // file read into storage. Reading first keeps the I/O out of decode times
+    bool readAsset(const std::string& path, std::vector<char>& storage, const void*& data, size_t& size) {
+        AssetPack::Blob blob;
+        if (AssetPack::lookup(path, blob)) {
+            data = blob.data;
+            size = blob.size;
+            return true;
+        }
+
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return false;
+        storage.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        data = storage.data();
+        size = storage.size();
+        return true;
+    }
+
+    // Times a worker job's read and decode against the timeline, if any
+    struct JobTimer {
+        explicit JobTimer(const StartupTimeline* timeline) : timeline(timeline) {
+            if (timeline) start = last = timeline->now();
+        }
+        double lap() {
+            if (!timeline) return 0.0;
+            const double now = timeline->now();
+            const double elapsed = now - last;
+            last = now;
+            return elapsed;
+        }
+
+        const StartupTimeline* timeline;
+        double start{0.0};
+        double last{0.0};
+    };
+}
+
+AssetLoader::~AssetLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        jobs.clear();
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void AssetLoader::queue(std::function<Result()> job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+        ++total;
+    }
+    wake.notify_one();
+}
+
+// sf::Image decoding is CPU only; the GPU upload waits for pump()
+void AssetLoader::queueImage(const std::string& path) {
+    queue([path, placeholder = headless, timeline = timeline] {
+        Result result;
+        result.kind = Result::Kind::IMAGE;
+        result.path = path;
+        if (placeholder) {
+            result.ok = true;
+            return result;
+        }
+        JobTimer timer(timeline);
+        std::vector<char> storage;
+        const void* data = nullptr;
+        result.ok = readAsset(path, storage, data, result.bytes);
+        result.ioMs = timer.lap();
+        result.ok = result.ok && result.image.loadFromMemory(data, result.bytes);
+        result.decodeMs = timer.lap();
+        result.startMs = timer.start;
+        return result;
+    });
+}
+
+void AssetLoader::queueTable(const std::string& path) {
+    queue([path, timeline = timeline] {
+        Result result;
+        result.kind = Result::Kind::TABLE;
+        result.path = path;
+        JobTimer timer(timeline);
+        std::vector<char> storage;
+        const void* data = nullptr;
+        if (readAsset(path, storage, data, result.bytes)) {
+            result.ioMs = timer.lap();
+            std::istringstream text(std::string(static_cast<const char*>(data), result.bytes));
+            result.table = parseTable(text);
+            result.decodeMs = timer.lap();
+        }
+        result.ok = !result.table.empty();
+        result.startMs = timer.start;
+        return result;
+    });
+}
+
+void AssetLoader::queueSound(const std::string& name, const std::string& path) {
+    queue([name, path, timeline = timeline] {
+        Result result;
+        result.kind = Result::Kind::SOUND;
+        result.path = path;
+        result.name = name;
+        JobTimer timer(timeline);
+        std::vector<char> storage;
+        const void* data = nullptr;
+        if (readAsset(path, storage, data, result.bytes)) {
+            result.ioMs = timer.lap();
+            result.clip = SoundManager::decode(data, result.bytes);
+            result.decodeMs = timer.lap();
+        }
+        result.ok = !result.clip.empty();
+        result.startMs = timer.start;
+        return result;
+    });
+}
+
+// One worker per spare core, capped at four; the main thread keeps drawing the intro
+void AssetLoader::start() {
+    if (!workers.empty()) return;
+
+    const unsigned cores = std::thread::hardware_concurrency();
+    const unsigned count = std::max(1u, std::min(4u, cores > 1 ? cores - 1 : 1u));
+    for (unsigned i = 0; i < count; ++i) {
+        workers.emplace_back(&AssetLoader::workerLoop, this);
+    }
+}
+
+void AssetLoader::workerLoop() {
+    for (;;) {
+        std::function<Result()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping) return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        Result result = job();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        results.push_back(std::move(result));
+    }
+}
+
+// Main thread only. Finishes queued results until budgetMs is spent, so a burst
+// of texture uploads is spread over several intro frames
+void AssetLoader::pump(float budgetMs) {
+    sf::Clock budget;
+    for (;;) {
+        Result result;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (results.empty()) return;
+            result = std::move(results.front());
+            results.pop_front();
+        }
+
+        finish(result);
+        ++finished;
+
+        if (budget.getElapsedTime().asSeconds() * 1000.0f >= budgetMs) return;
+    }
+}
+
+void AssetLoader::finish(Result& result) {
+    if (!result.ok) {
+        std::cerr << "fail " << result.path << std::endl;
+        return;
+    }
+    if (timeline) {
+        timeline->add(result.path, StartupTimeline::Kind::IO, result.startMs, result.ioMs, result.bytes);
+        timeline->add(result.path, StartupTimeline::Kind::DECODE, result.startMs + result.ioMs, result.decodeMs);
+    }
+
+    switch (result.kind) {
+        case Result::Kind::IMAGE: {
+            sf::Texture& texture = textures[result.path];
+            if (headless) break;
+            const double uploadStart = timeline ? timeline->now() : 0.0;
+            if (!texture.loadFromImage(result.image)) {
+                std::cerr << "fail " << result.path << std::endl;
+                textures.erase(result.path);
+                return;
+            }
+            texture.setSmooth(false);
+            if (timeline) {
+                const sf::Vector2u size = result.image.getSize();
+                timeline->add(result.path, StartupTimeline::Kind::UPLOAD, uploadStart, timeline->now() - uploadStart,
+                              static_cast<size_t>(size.x) * size.y * 4);
+            }
+            break;
+        }
+        case Result::Kind::TABLE:
+            tables[result.path] = std::move(result.table);
+            break;
+        case Result::Kind::SOUND:
+            if (sounds) {
+                sounds->addSound(result.name, result.path, std::move(result.clip));
+            }
+            break;
+    }
+}
+
+const sf::Texture* AssetLoader::texture(const std::string& path) const {
+    auto it = textures.find(path);
+    return it != textures.end() ? &it->second : nullptr;
+}
+
+const AssetLoader::Table* AssetLoader::table(const std::string& path) const {
+    auto it = tables.find(path);
+    return it != tables.end() ? &it->second : nullptr;
+}
+
+// Comma separated integers, one map row per line; bad cells read as 0
+AssetLoader::Table AssetLoader::parseTable(const std::string& path) {
+    Table table;
+    AssetPack::read(path, [&table](std::istream& in) {
+        table = parseTable(in);
+        return true;
+    });
+    return table;
+}
+
+AssetLoader::Table AssetLoader::parseTable(std::istream& in) {
+    Table table;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::vector<int> row;
+        std::istringstream stream(line);
+        std::string cell;
+
+        while (std::getline(stream, cell, ',')) {
+            try {
+                row.push_back(std::stoi(cell));
+            } catch (...) {
+                row.push_back(0);
+            }
+        }
+
+        if (!row.empty()) {
+            table.push_back(std::move(row));
+        }
+    }
+    return table;
+}
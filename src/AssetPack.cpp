@@ -0,0 +1,146 @@
+#include "../include/AssetPack.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+
+namespace {
+    constexpr char MAGIC[4] = {'S', 'P', 'A', 'K'};
+
+    // Loader workers look paths up while the main thread mounts and unmounts
+    std::mutex mountMutex;
+    std::vector<const AssetPack*> mountedPacks;
+}
+
+// Maps the pack and checks the index fits inside it. Contents are not hashed
+// here; that would read every byte on start
+bool AssetPack::open(const std::string& path) {
+    entries.clear();
+    if (!file.open(path)) return false;
+
+    const uint8_t* data = file.data();
+    const size_t size = file.size();
+
+    Header header{};
+    if (size < sizeof(Header)) {
+        file.close();
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(Header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+        header.entryCount > (size - sizeof(Header)) / sizeof(Entry)) {
+        std::cerr << "fail " << path << std::endl;
+        file.close();
+        return false;
+    }
+
+    entries.resize(header.entryCount);
+    std::memcpy(entries.data(), data + sizeof(Header), header.entryCount * sizeof(Entry));
+
+    // Names are only for listing; a pack whose names don't add up still loads
+    names.clear();
+    const size_t namesStart = sizeof(Header) + header.entryCount * sizeof(Entry);
+    if (header.namesSize <= size - namesStart) {
+        const char* cursor = reinterpret_cast<const char*>(data + namesStart);
+        const char* end = cursor + header.namesSize;
+        while (cursor < end && names.size() < entries.size()) {
+            const char* terminator = static_cast<const char*>(std::memchr(cursor, '\0', static_cast<size_t>(end - cursor)));
+            if (!terminator) break;
+            names.emplace_back(cursor, terminator);
+            cursor = terminator + 1;
+        }
+    }
+    if (names.size() != entries.size()) {
+        names.clear();
+    }
+
+    for (const auto& entry : entries) {
+        if (entry.offset > size || entry.size > size - entry.offset) {
+            std::cerr << "fail " << path << std::endl;
+            entries.clear();
+            file.close();
+            return false;
+        }
+    }
+    return true;
+}
+
+// Binary search over the hash-sorted index
+bool AssetPack::find(const std::string& path, Blob& blob) const {
+    if (!isOpen()) return false;
+
+    const uint64_t key = hashPath(path);
+    auto it = std::lower_bound(entries.begin(), entries.end(), key,
+                               [](const Entry& entry, uint64_t value) { return entry.pathHash < value; });
+    if (it == entries.end() || it->pathHash != key) return false;
+
+    blob.data = file.data() + it->offset;
+    blob.size = static_cast<size_t>(it->size);
+    blob.checksum = it->checksum;
+    return true;
+}
+
+bool AssetPack::verify(const Entry& entry) const {
+    return isOpen() && hash(file.data() + entry.offset, static_cast<size_t>(entry.size)) == entry.checksum;
+}
+
+void AssetPack::mount(const AssetPack* pack) {
+    if (!pack) return;
+    std::lock_guard<std::mutex> lock(mountMutex);
+    if (std::find(mountedPacks.begin(), mountedPacks.end(), pack) == mountedPacks.end()) {
+        mountedPacks.push_back(pack);
+    }
+}
+
+void AssetPack::unmount(const AssetPack* pack) {
+    std::lock_guard<std::mutex> lock(mountMutex);
+    mountedPacks.erase(std::remove(mountedPacks.begin(), mountedPacks.end(), pack), mountedPacks.end());
+}
+
+bool AssetPack::lookup(const std::string& path, Blob& blob) {
+    std::lock_guard<std::mutex> lock(mountMutex);
+    for (auto it = mountedPacks.rbegin(); it != mountedPacks.rend(); ++it) {
+        if ((*it)->find(path, blob)) return true;
+    }
+    return false;
+}
+
+// "./assets/Arial.ttf", "assets\\arial.ttf" and "assets/arial.ttf" are one asset
+std::string AssetPack::normalize(const std::string& path) {
+    std::string result = path;
+    std::replace(result.begin(), result.end(), '\\', '/');
+    while (result.compare(0, 2, "./") == 0) {
+        result.erase(0, 2);
+    }
+    std::transform(result.begin(), result.end(), result.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return result;
+}
+
+uint64_t AssetPack::hash(const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    uint64_t value = 14695981039346656037ull;
+    for (size_t i = 0; i < size; ++i) {
+        value ^= bytes[i];
+        value *= 1099511628211ull;
+    }
+    return value;
+}
+
+uint64_t AssetPack::hashPath(const std::string& path) {
+    const std::string key = normalize(path);
+    return hash(key.data(), key.size());
+}
+
+AssetPack::Type AssetPack::typeOf(const std::string& path) {
+    const std::string key = normalize(path);
+    const size_t dot = key.rfind('.');
+    const std::string extension = dot == std::string::npos ? "" : key.substr(dot + 1);
+
+    if (extension == "png" || extension == "jpg" || extension == "bmp") return Type::IMAGE;
+    if (extension == "ttf" || extension == "otf") return Type::FONT;
+    if (extension == "csv") return Type::TABLE;
+    if (extension == "mp3" || extension == "wav" || extension == "ogg" || extension == "flac") return Type::SOUND;
+    return Type::OTHER;
+}
@@ -0,0 +1,122 @@
+#include "../include/AudioMixer.h"
+#include <algorithm>
+
+AudioMixer::AudioMixer() {
+    initialize(CHANNELS, SAMPLE_RATE, {sf::SoundChannel::FrontLeft, sf::SoundChannel::FrontRight});
+}
+
+// The stream thread reads our buffers, so it has to stop before they go away
+AudioMixer::~AudioMixer() {
+    stop();
+}
+
+// Starts a clip on a free voice, stealing one if all are busy. Returns false when
+// the clip was dropped because every playing voice outranks it
+bool AudioMixer::trigger(const PcmClip& clip) {
+    if (clip.empty()) return false;
+
+    std::lock_guard<std::mutex> lock(voiceMutex);
+
+    Voice* target = nullptr;
+    for (auto& voice : voices) {
+        if (!voice.samples) {
+            target = &voice;
+            break;
+        }
+        if (!target || voice.priority < target->priority ||
+            (voice.priority == target->priority && voice.started < target->started)) {
+            target = &voice;
+        }
+    }
+
+    if (target->samples && target->priority > clip.priority) {
+        return false;
+    }
+
+    target->samples = clip.samples;
+    target->length = clip.length;
+    target->cursor = 0;
+    target->priority = clip.priority;
+    target->started = ++triggerCount;
+    return true;
+}
+
+void AudioMixer::stopAll() {
+    std::lock_guard<std::mutex> lock(voiceMutex);
+    for (auto& voice : voices) {
+        voice = Voice{};
+    }
+}
+
+// Runs on the stream thread: sums every live voice into one fixed-size block of
+// floats, then clamps it down to 16-bit. The stream never ends; idle blocks are silence
+bool AudioMixer::onGetData(Chunk& data) {
+    mixBuffer.fill(0.0f);
+
+    {
+        std::lock_guard<std::mutex> lock(voiceMutex);
+        for (auto& voice : voices) {
+            if (!voice.samples) continue;
+
+            const size_t count = std::min(BLOCK_SAMPLES, voice.length - voice.cursor);
+            const float* source = voice.samples + voice.cursor;
+            float* mix = mixBuffer.data();
+            for (size_t i = 0; i < count; ++i) {
+                mix[i] += source[i];
+            }
+
+            voice.cursor += count;
+            if (voice.cursor >= voice.length) {
+                voice = Voice{};
+            }
+        }
+    }
+
+    for (size_t i = 0; i < BLOCK_SAMPLES; ++i) {
+        const float sample = std::clamp(mixBuffer[i], -1.0f, 1.0f);
+        outputBuffer[i] = static_cast<int16_t>(sample * 32767.0f);
+    }
+
+    data.samples = outputBuffer.data();
+    data.sampleCount = BLOCK_SAMPLES;
+    return true;
+}
+
+void AudioMixer::onSeek(sf::Time) {
+}
+
+// Brings decoded 16-bit audio into the mixer's format once at load time: mono is
+// duplicated to both sides, extra channels are dropped and other rates are
+// linearly resampled, so mixing is a plain add
+PcmClip AudioMixer::convert(const int16_t* samples, uint64_t sampleCount, unsigned channels, unsigned sampleRate) {
+    PcmClip clip;
+    if (!samples || channels == 0 || sampleRate == 0) return clip;
+
+    const size_t sourceFrames = static_cast<size_t>(sampleCount / channels);
+    if (sourceFrames == 0) return clip;
+
+    const double step = static_cast<double>(sampleRate) / SAMPLE_RATE;
+    const size_t frames = static_cast<size_t>(static_cast<double>(sourceFrames) / step);
+    clip.storage.resize(frames * CHANNELS);
+
+    auto read = [&](size_t frame, unsigned channel) {
+        const unsigned source = std::min(channel, channels - 1);
+        return static_cast<float>(samples[frame * channels + source]) / 32768.0f;
+    };
+
+    for (size_t frame = 0; frame < frames; ++frame) {
+        const double position = static_cast<double>(frame) * step;
+        const size_t index = static_cast<size_t>(position);
+        const size_t next = std::min(index + 1, sourceFrames - 1);
+        const float t = static_cast<float>(position - static_cast<double>(index));
+
+        for (unsigned channel = 0; channel < CHANNELS; ++channel) {
+            const float a = read(index, channel);
+            const float b = read(next, channel);
+            clip.storage[frame * CHANNELS + channel] = a + (b - a) * t;
+        }
+    }
+    clip.samples = clip.storage.data();
+    clip.length = clip.storage.size();
+    return clip;
+}
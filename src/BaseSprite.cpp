@@ -1,11 +1,14 @@
 #include "../include/BaseSprite.h"
 #include <iostream>
 
-BaseSprite::BaseSprite(const sf::Vector2f& pos, bool animated)
-        : position(pos)
-        , isAnimated(animated)
-        , sprite(texture)
+BaseSprite::BaseSprite(const SpriteArchetype& type, const sf::Vector2f& pos)
+        : archetype(type)
+        , position(pos)
+        , sprite(*type.texture)
 {
+    if (archetype.clip) {
+        playClip(*archetype.clip, true);
+    }
     sprite.setPosition(position);
 
     sprite.setColor(sf::Color(255, 255, 255, 255));
@@ -17,24 +20,28 @@ void BaseSprite::setOpacity(uint8_t alpha) {
     sprite.setColor(color);
 }
 
-void BaseSprite::update(float deltaTime) {
-    if (!isAnimated || frames.empty()) return;
+void BaseSprite::update(float) {}
 
-    animationTimer += deltaTime;
-    if (animationTimer >= frameTime) {
-        animationTimer = 0.0f;
-        currentFrame = (currentFrame + 1) % frames.size();
-        sprite.setTextureRect(frames[currentFrame]);
+// Steps the sprite's clip, called once per frame from the engine's animation pass
+void BaseSprite::advanceAnimation(float deltaTime) {
+    if (archetype.animated && animation.advance(deltaTime)) {
+        sprite.setTextureRect(animation.frameRect());
     }
 }
 
+// Switches clip and shows its current frame right away
+void BaseSprite::playClip(const AnimationClip& clip, bool restart) {
+    animation.play(clip, restart);
+    sprite.setTextureRect(animation.frameRect());
+}
+
 //function to render the sprite
-void BaseSprite::render(sf::RenderWindow& window) {
-    window.draw(sprite);
+void BaseSprite::render(RenderSnapshot& target) {
+    target.draw(sprite);
 }
 
 //function to set the position of the sprite
 void BaseSprite::setPosition(const sf::Vector2f& pos) {
     position = pos;
     sprite.setPosition(position);
-}
\ No newline at end of file
+}
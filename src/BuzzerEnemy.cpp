@@ -1,37 +1,11 @@
 #include "../include/BuzzerEnemy.h"
-#include "SoundManager.h"
-#include <iostream>
+#include "../include/LevelData.h"
 #include <cmath>
 
-BuzzerEnemy::BuzzerEnemy(const sf::Vector2f& pos)
-        : BaseSprite(pos, true), originalX(pos.x), moveDistance(0.0f), movingRight(true) {
-    if (!texture.loadFromFile("./assets/enemies_sheet_fixed.png")) {
-        std::cerr << "fail" << std::endl;
-        return;
-    }
-
-    normalFrames[0] = sf::IntRect({8, 174}, {48, 32});
-    normalFrames[1] = sf::IntRect({64, 174}, {48, 32});
-    normalFrames[2] = sf::IntRect({8, 214}, {48, 24});
-    normalFrames[3] = sf::IntRect({64, 214}, {48, 24});
-    shootingFrame = sf::IntRect({72, 246}, {56, 56});
-    projectileFrame = sf::IntRect({120, 150}, {16, 16});
-
-    sprite.setTexture(texture);
-    initializeFrames();
-    sprite.setTextureRect(normalFrames[0]);
-    sprite.setPosition(position);
-    frameTime = 0.15f;
-
+BuzzerEnemy::BuzzerEnemy(const SpriteArchetypes& types, const sf::Vector2f& pos)
+        : BaseSprite(types.get(SpriteKind::BUZZER), pos), originalX(pos.x), moveDistance(0.0f), movingRight(true) {
     sprite.setScale(sf::Vector2f(-1.f, 1.f));
     sprite.setOrigin(sf::Vector2f(sprite.getGlobalBounds().size.x, 0.f));
-    SoundManager::getInstance().loadSound("badnik-death", "./assets/badnik-death.mp3");
-}
-
-void BuzzerEnemy::initializeFrames() {
-    for(int i = 0; i < 4; ++i) {
-        frames.push_back(normalFrames[i]);
-    }
 }
 
 void BuzzerEnemy::update(float deltaTime) {
@@ -48,7 +22,7 @@ void BuzzerEnemy::update(float deltaTime) {
         if (shootingTimer >= SHOOTING_DURATION) {
             isShooting = false;
             shootingTimer = 0.0f;
-            sprite.setTextureRect(normalFrames[currentFrame]);
+            playClip(*archetype.clip);
         }
     }
 
@@ -56,7 +30,6 @@ void BuzzerEnemy::update(float deltaTime) {
     updateProjectiles(deltaTime);
     if (!isShooting) {
         updateMovement(deltaTime);
-        updateAnimation(deltaTime);
     }
 }
 
@@ -86,29 +59,19 @@ void BuzzerEnemy::updateMovement(float deltaTime) {
     sprite.setPosition(position);
 }
 
-void BuzzerEnemy::updateAnimation(float deltaTime) {
-    if (isShooting) return;
-    animationTimer += deltaTime;
-    if (animationTimer >= frameTime) {
-        animationTimer = 0;
-        currentFrame = (currentFrame + 1) % 4;
-        sprite.setTextureRect(normalFrames[currentFrame]);
-    }
-}
-
-void BuzzerEnemy::render(sf::RenderWindow& window) const {
+void BuzzerEnemy::render(RenderSnapshot& target) const {
     if (!isActive) {
-        if (freedAnimal) freedAnimal->render(window);
+        if (freedAnimal) freedAnimal->render(target);
         return;
     }
-    window.draw(sprite);
+    target.draw(sprite);
 
-    sf::Sprite projectileSprite(texture);
-    projectileSprite.setTextureRect(projectileFrame);
+    sf::Sprite projectileSprite(*archetype.texture);
+    projectileSprite.setTextureRect(archetype.projectileFrame);
     for (const auto& proj : projectiles) {
         if (proj.active) {
             projectileSprite.setPosition(proj.position);
-            window.draw(projectileSprite);
+            target.draw(projectileSprite);
         }
     }
 }
@@ -120,7 +83,7 @@ void BuzzerEnemy::shoot(const sf::Vector2f& targetPos) {
     isShooting = true;
     attackCooldown = ATTACK_COOLDOWN;
     shootingTimer = 0.0f;
-    sprite.setTextureRect(shootingFrame);
+    playClip(*archetype.actionClip);
 
     sf::Vector2f shootPos = position + sf::Vector2f(
             sprite.getGlobalBounds().size.x / 2,
@@ -161,11 +124,11 @@ bool BuzzerEnemy::checkProjectileCollision(const sf::FloatRect& bounds) const {
 }
 
 //function that kills the enemy
-void BuzzerEnemy::die() {
+void BuzzerEnemy::die(const EngineContext& context) {
     if (isActive) {
         isActive = false;
-        SoundManager::getInstance().playSound("badnik-death");
-        freedAnimal = std::make_unique<AnimalSprite>(position, (std::rand() % 2) == 0);
+        context.play(archetype.sound);
+        freedAnimal = std::make_unique<AnimalSprite>(context.level->archetypes, position, context.random->below(2) == 0);
         if (collisionMap) freedAnimal->setCollisionMap(collisionMap);
     }
 }
@@ -193,12 +156,10 @@ void BuzzerEnemy::reset() {
     sprite.setScale(sf::Vector2f(-1.f, 1.f));
     sprite.setOrigin(sf::Vector2f(sprite.getGlobalBounds().size.x, 0.f));
     sprite.setPosition(position);
-    sprite.setTextureRect(normalFrames[0]);
+    playClip(*archetype.clip, true);
     isShooting = false;
     shootingTimer = 0.0f;
     attackCooldown = 0.0f;
     projectiles.clear();
-    currentFrame = 0;
-    animationTimer = 0.0f;
     freedAnimal.reset();
 }
\ No newline at end of file
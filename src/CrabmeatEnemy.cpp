@@ -1,47 +1,15 @@
 #include "../include/CrabmeatEnemy.h"
-#include "../include/SoundManager.h"
-#include <iostream>
+#include "../include/LevelData.h"
 #include <cmath>
 
-CrabmeatEnemy::CrabmeatEnemy(const sf::Vector2f& pos)
-        : BaseSprite(pos, true)
+CrabmeatEnemy::CrabmeatEnemy(const SpriteArchetypes& types, const sf::Vector2f& pos)
+        : BaseSprite(types.get(SpriteKind::CRABMEAT), pos)
         , originalX(pos.x)
         , isActive(true)
         , movingRight(true)
 {
-    if (!texture.loadFromFile("./assets/enemies_sheet_fixed.png")) {
-        std::cerr << "fail" << std::endl;
-        return;
-    }
-
-    sprite.setTexture(texture);
-    initializeFrames();
-    sprite.setTextureRect(frames[0]);
-    sprite.setPosition(position);
-    frameTime = 0.2f;
-
     sprite.setScale(sf::Vector2f(1.f, 1.f));
     sprite.setOrigin(sf::Vector2f(0.f, 0.f));
-
-
-    SoundManager::getInstance().loadSound("badnik-death", "./assets/badnik-death.mp3");
-}
-
-void CrabmeatEnemy::initializeFrames() {
-
-    walkFrames = {
-            sf::IntRect(sf::Vector2i(8, 29), sf::Vector2i(48, 32)),
-            sf::IntRect(sf::Vector2i(64, 29), sf::Vector2i(48, 32)),
-            sf::IntRect(sf::Vector2i(120, 25), sf::Vector2i(48, 40)),
-            sf::IntRect(sf::Vector2i(176, 25), sf::Vector2i(48, 40)),
-            sf::IntRect(sf::Vector2i(232, 29), sf::Vector2i(48, 32))
-    };
-
-    attackFrames = {
-            sf::IntRect(sf::Vector2i(120, 25), sf::Vector2i(48, 40)),
-    };
-
-    frames = walkFrames;
 }
 
 void CrabmeatEnemy::update(float deltaTime) {
@@ -70,7 +38,7 @@ void CrabmeatEnemy::update(float deltaTime) {
         if (shootingTimer >= SHOOTING_DURATION) {
             isShooting = false;
             shootingTimer = 0.0f;
-            frames = walkFrames;
+            playClip(*archetype.clip);
         }
     }
 
@@ -80,8 +48,6 @@ void CrabmeatEnemy::update(float deltaTime) {
     if (!isShooting) {
         updatePatrolMovement(deltaTime);
     }
-
-    updateAnimation(deltaTime);
 }
 
 
@@ -108,15 +74,6 @@ void CrabmeatEnemy::updateProjectiles(float deltaTime) {
     }
 }
 
-void CrabmeatEnemy::updateAnimation(float deltaTime) {
-    animationTimer += deltaTime;
-    if (animationTimer >= FRAME_TIME) {
-        animationTimer = 0;
-        currentFrame = (currentFrame + 1) % frames.size();
-        sprite.setTextureRect(frames[currentFrame]);
-    }
-}
-
 // Check if the player is in range of the enemy
 bool CrabmeatEnemy::checkPlayerInRange(const sf::FloatRect& playerBounds) const {
 
@@ -146,7 +103,7 @@ void CrabmeatEnemy::shoot() {
     isShooting = true;
     attackCooldown = ATTACK_COOLDOWN;
     shootingTimer = 0.0f;
-    frames = attackFrames;
+    playClip(*archetype.actionClip);
 
 
     sf::Vector2f shootPos = position + sf::Vector2f(
@@ -237,12 +194,12 @@ void CrabmeatEnemy::updatePatrolMovement(float deltaTime) {
     sprite.setPosition(position);
 }
 
-void CrabmeatEnemy::die() {
+void CrabmeatEnemy::die(const EngineContext& context) {
     if (isActive) {
         isActive = false;
-        SoundManager::getInstance().playSound("badnik-death");
+        context.play(archetype.sound);
 
-        freedAnimal = std::make_unique<AnimalSprite>(position, true);
+        freedAnimal = std::make_unique<AnimalSprite>(context.level->archetypes, position, true);
         if (freedAnimal && collisionMap) {
             freedAnimal->setCollisionMap(collisionMap);
         }
@@ -250,20 +207,20 @@ void CrabmeatEnemy::die() {
 }
 
 // Render the enemy
-void CrabmeatEnemy::render(sf::RenderWindow& window) const {
+void CrabmeatEnemy::render(RenderSnapshot& target) const {
     if (isActive) {
-        window.draw(sprite);
+        target.draw(sprite);
 
-        sf::Sprite projectileSprite(texture);
-        projectileSprite.setTextureRect(projectileFrame);
+        sf::Sprite projectileSprite(*archetype.texture);
+        projectileSprite.setTextureRect(archetype.projectileFrame);
         for (const auto& proj : projectiles) {
             if (proj.active) {
                 projectileSprite.setPosition(proj.position);
-                window.draw(projectileSprite);
+                target.draw(projectileSprite);
             }
         }
     } else if (freedAnimal) {
-        freedAnimal->render(window);
+        freedAnimal->render(target);
     }
 }
 bool CrabmeatEnemy::isAlive() const {
@@ -293,13 +250,10 @@ void CrabmeatEnemy::reset() {
     sprite.setScale(sf::Vector2f(1.f, 1.f));
     sprite.setOrigin(sf::Vector2f(0.f, 0.f));
     sprite.setPosition(position);
-    sprite.setTextureRect(frames[0]);
+    playClip(*archetype.clip, true);
 
 
-    float movementTimer = 0.0f;
     pauseTimer = 0.0f;
-    animationTimer = 0.0f;
-    currentFrame = 0;
 
 
     freedAnimal.reset();
@@ -308,6 +262,5 @@ void CrabmeatEnemy::reset() {
     shootingTimer = 0.0f;
     attackCooldown = 0.0f;
     projectiles.clear();
-    frames = walkFrames;
 }
 
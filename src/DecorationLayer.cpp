@@ -0,0 +1,95 @@
+#include "../include/DecorationLayer.h"
+#include <cmath>
+
+DecorationLayer::Sheet& DecorationLayer::sheetFor(const sf::Texture& texture) {
+    for (auto& sheet : sheets) {
+        if (sheet->texture == &texture) return *sheet;
+    }
+    sheets.push_back(std::make_unique<Sheet>());
+    sheets.back()->texture = &texture;
+    return *sheets.back();
+}
+
+DecorationLayer::QuadRef DecorationLayer::appendQuad(Sheet& sheet, const sf::Vector2f& pos, const sf::IntRect& rect) {
+    ChunkKey key(static_cast<int>(std::floor(pos.x / chunkSize)),
+                 static_cast<int>(std::floor(pos.y / chunkSize)));
+    auto& chunk = sheet.chunks.try_emplace(key, sf::PrimitiveType::Triangles).first->second;
+
+    const sf::Vector2f size(rect.size);
+    const sf::Vector2f corners[6] = {
+            {0.f, 0.f}, {size.x, 0.f}, {0.f, size.y},
+            {0.f, size.y}, {size.x, 0.f}, {size.x, size.y}
+    };
+
+    QuadRef quad{&chunk, chunk.getVertexCount()};
+    for (const auto& corner : corners) {
+        chunk.append(sf::Vertex{pos + corner, sf::Color::White, sf::Vector2f(rect.position) + corner});
+    }
+    return quad;
+}
+
+void DecorationLayer::setTexCoords(const QuadRef& quad, const sf::IntRect& rect) {
+    const sf::Vector2f tex(rect.position);
+    const sf::Vector2f size(rect.size);
+    auto& vertices = *quad.chunk;
+    vertices[quad.firstVertex + 0].texCoords = tex;
+    vertices[quad.firstVertex + 1].texCoords = tex + sf::Vector2f(size.x, 0.f);
+    vertices[quad.firstVertex + 2].texCoords = tex + sf::Vector2f(0.f, size.y);
+    vertices[quad.firstVertex + 3].texCoords = tex + sf::Vector2f(0.f, size.y);
+    vertices[quad.firstVertex + 4].texCoords = tex + sf::Vector2f(size.x, 0.f);
+    vertices[quad.firstVertex + 5].texCoords = tex + size;
+}
+
+void DecorationLayer::add(const sf::Texture& texture, const sf::IntRect& rect, const sf::Vector2f& pos) {
+    appendQuad(sheetFor(texture), pos, rect);
+}
+
+// Frames of one clip are expected to share a size, only the texture coordinates change
+void DecorationLayer::add(const sf::Texture& texture, const AnimationClip& clip, const sf::Vector2f& pos) {
+    auto& entry = animated[&clip];
+    entry.animation.play(clip);
+    entry.quads.push_back(appendQuad(sheetFor(texture), pos, entry.animation.frameRect()));
+}
+
+void DecorationLayer::clear() {
+    animated.clear();
+    sheets.clear();
+}
+
+void DecorationLayer::update(float deltaTime) {
+    for (auto& [clip, entry] : animated) {
+        if (!entry.animation.advance(deltaTime)) continue;
+
+        const sf::IntRect& rect = entry.animation.frameRect();
+        for (const auto& quad : entry.quads) {
+            setTexCoords(quad, rect);
+        }
+    }
+}
+
+// Draws only the chunks that overlap the target's current view
+void DecorationLayer::render(RenderSnapshot& target) const {
+    const sf::View& view = target.getView();
+    const sf::Vector2f topLeft = view.getCenter() - view.getSize() / 2.0f;
+    const sf::Vector2f bottomRight = topLeft + view.getSize();
+
+    // Decorations may hang over the edge of their chunk, so look one chunk further back
+    const int startX = static_cast<int>(std::floor(topLeft.x / chunkSize)) - 1;
+    const int startY = static_cast<int>(std::floor(topLeft.y / chunkSize)) - 1;
+    const int endX = static_cast<int>(std::floor(bottomRight.x / chunkSize));
+    const int endY = static_cast<int>(std::floor(bottomRight.y / chunkSize));
+
+    for (const auto& sheet : sheets) {
+        sf::RenderStates states;
+        states.texture = sheet->texture;
+
+        for (int x = startX; x <= endX; ++x) {
+            for (int y = startY; y <= endY; ++y) {
+                auto chunk = sheet->chunks.find(ChunkKey(x, y));
+                if (chunk != sheet->chunks.end()) {
+                    target.draw(chunk->second, states);
+                }
+            }
+        }
+    }
+}
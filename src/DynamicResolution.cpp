@@ -0,0 +1,42 @@
+#include "../include/DynamicResolution.h"
+#include <algorithm>
+
+void DynamicResolution::setEnabled(bool value) {
+    enabled = value;
+    if (!enabled) {
+        scale = 1.0f;
+        framesOver = 0;
+        framesUnder = 0;
+    }
+}
+
+// frameMs is the full interval between frames, which the frame limiter pads up to
+// the budget, so it only shows when we are late. workMs is the time spent before
+// presenting and is what tells us there is headroom to raise the scale again
+float DynamicResolution::update(float frameMs, float workMs) {
+    // Loading stalls and window drags say nothing about rendering cost
+    if (!enabled || frameMs > MAX_SAMPLE_MS) {
+        return scale;
+    }
+
+    averageFrameMs += (frameMs - averageFrameMs) * SMOOTHING;
+    averageWorkMs += (workMs - averageWorkMs) * SMOOTHING;
+
+    if (averageFrameMs > budgetMs * OVER_BUDGET) {
+        framesUnder = 0;
+        if (++framesOver >= FRAMES_TO_DROP && scale > MIN_SCALE) {
+            scale = std::max(MIN_SCALE, scale - SCALE_STEP);
+            framesOver = 0;
+        }
+    } else if (averageWorkMs < budgetMs * UNDER_BUDGET) {
+        framesOver = 0;
+        if (++framesUnder >= FRAMES_TO_RAISE && scale < 1.0f) {
+            scale = std::min(1.0f, scale + SCALE_STEP);
+            framesUnder = 0;
+        }
+    } else {
+        framesOver = 0;
+        framesUnder = 0;
+    }
+    return scale;
+}
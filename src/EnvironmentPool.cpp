@@ -0,0 +1,67 @@
+#include "../include/EnvironmentPool.h"
+#include <stdexcept>
+
+// Engines are built one after another; only stepping runs in parallel
+EnvironmentPool::EnvironmentPool(size_t count, unsigned workerCount) : jobs(workerCount) {
+    level = GameEngine::loadHeadlessLevel(pack);
+
+    engines.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        engines.push_back(std::make_unique<GameEngine>(level));
+    }
+
+    observations.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        observe(i);
+    }
+}
+
+EnvironmentPool::~EnvironmentPool() {
+    engines.clear();
+    AssetPack::unmount(&pack);
+}
+
+// One fixed step per engine, one engine per job. Engines that are done stand
+// still until they are reset
+const std::vector<EnvironmentPool::Observation>& EnvironmentPool::step(const std::vector<Action>& actions) {
+    if (actions.size() != engines.size()) {
+        throw std::runtime_error("fail action count");
+    }
+
+    jobs.parallelFor(engines.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            engines[i]->step(actions[i], STEP_SECONDS);
+            observe(i);
+        }
+    });
+    return observations;
+}
+
+void EnvironmentPool::reset(size_t index) {
+    engines[index]->resetGame();
+    observe(index);
+}
+
+void EnvironmentPool::resetAll() {
+    jobs.parallelFor(engines.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            reset(i);
+        }
+    });
+}
+
+void EnvironmentPool::observe(size_t index) {
+    GameEngine& engine = *engines[index];
+    Observation& observation = observations[index];
+
+    observation.state = engine.GetCurrentState();
+    observation.done = observation.state == GameState::GAME_OVER || observation.state == GameState::COMPLETED;
+    observation.lives = engine.getLives();
+    observation.score = engine.getScore();
+    observation.time = engine.getLevelTime();
+    if (const Player* player = engine.GetPlayer()) {
+        observation.position = player->getPosition();
+        observation.velocity = player->velocity;
+        observation.rings = player->getRingCount();
+    }
+}
@@ -1,32 +1,17 @@
 #include "../include/FishEnemy.h"
+#include "../include/LevelData.h"
 #include "../include/Player.h"
-#include "SoundManager.h"
-#include <iostream>
 #include <cmath>
 
-FishEnemy::FishEnemy(const sf::Vector2f& pos, float targetY)
-        : BaseSprite(pos, true)
+FishEnemy::FishEnemy(const SpriteArchetypes& types, const sf::Vector2f& pos, float targetY)
+        : BaseSprite(types.get(SpriteKind::FISH), pos)
         , startY(pos.y)
         , endY(targetY * 4)
 {
-    if (!texture.loadFromFile("./assets/enemies_sheet_fixed.png")) {
-        std::cerr << "fail" << std::endl;
-        return;
-    }
-
-    sprite.setTexture(texture);
-    initializeFrames();
-    sprite.setTextureRect(frames[0]);
-    sprite.setPosition(position);
-    frameTime = 0.2f;
-
-
-    SoundManager::getInstance().loadSound("badnik-death", "./assets/badnik-death.mp3");
 }
 
 void FishEnemy::initializeFrames() {
-    frames.emplace_back(sf::IntRect(sf::Vector2i(157, 209), sf::Vector2i(32, 32)));
-    frames.emplace_back(sf::IntRect(sf::Vector2i(197, 209), sf::Vector2i(32, 32)));
+    playClip(*archetype.clip, true);
 }
 
 void FishEnemy::update(float deltaTime) {
@@ -40,14 +25,6 @@ void FishEnemy::update(float deltaTime) {
         return;
     }
 
-
-    animationTimer += deltaTime;
-    if (animationTimer >= frameTime) {
-        currentFrame = (currentFrame + 1) % frames.size();
-        sprite.setTextureRect(frames[currentFrame]);
-        animationTimer = 0;
-    }
-
     updateVerticalMovement(deltaTime);
 }
 
@@ -62,14 +39,14 @@ void FishEnemy::updateVerticalMovement(float deltaTime) {
     sprite.setPosition(position);
 }
 
-void FishEnemy::die() {
+void FishEnemy::die(const EngineContext& context) {
     if (isActive) {
         isActive = false;
 
-        SoundManager::getInstance().playSound("badnik-death");
+        context.play(archetype.sound);
 
-        bool moveRight = (std::rand() % 2) == 0;
-        freedAnimal = std::make_unique<AnimalSprite>(position, moveRight);
+        bool moveRight = context.random->below(2) == 0;
+        freedAnimal = std::make_unique<AnimalSprite>(context.level->archetypes, position, moveRight);
         if (collisionMap) {
             freedAnimal->setCollisionMap(collisionMap);
         }
@@ -82,11 +59,11 @@ sf::FloatRect FishEnemy::getCollisionBounds() const {
     return sprite.getGlobalBounds();
 }
 
-void FishEnemy::render(sf::RenderWindow& window) const {
+void FishEnemy::render(RenderSnapshot& target) const {
     if (isActive) {
-        window.draw(sprite);
+        target.draw(sprite);
     } else if (freedAnimal) {
-        freedAnimal->render(window);
+        freedAnimal->render(target);
     }
 }
 
@@ -97,10 +74,8 @@ void FishEnemy::reset() {
     movingUp = true;
 
     sprite.setPosition(position);
-    sprite.setTextureRect(frames[0]);
+    initializeFrames();
 
-    currentFrame = 0;
-    animationTimer = 0.0f;
     movementTimer = 0.0f;
 
 
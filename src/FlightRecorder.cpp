@@ -0,0 +1,120 @@
+#include "../include/FlightRecorder.h"
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+namespace {
+    // Half the ring has to be new before a slow frame dumps again, so a run of
+    // hitches (or the dump's own write) gives one trace, not one per frame
+    constexpr size_t DUMP_SPACING = FlightRecorder::CAPACITY / 2;
+
+    const char* stateName(GameState state) {
+        switch (state) {
+            case GameState::INTRO: return "intro";
+            case GameState::PLAYING: return "playing";
+            case GameState::PAUSED: return "paused";
+            case GameState::COMPLETED: return "completed";
+            case GameState::GAME_OVER: return "game_over";
+        }
+        return "unknown";
+    }
+
+    // Held buttons as one letter each, '-' when up
+    std::string inputString(const PlayerInput& input) {
+        std::string text = "-----";
+        if (input.left) text[0] = 'L';
+        if (input.right) text[1] = 'R';
+        if (input.up) text[2] = 'U';
+        if (input.down) text[3] = 'D';
+        if (input.jump) text[4] = 'J';
+        return text;
+    }
+
+    std::string escape(const std::string& text) {
+        std::string out;
+        for (char c : text) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += (c == '\n') ? ' ' : c;
+        }
+        return out;
+    }
+
+    void writeZone(std::ostream& out, const char* name, int track, double startMs, double durationMs) {
+        out << ",\n{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << track
+            << ",\"ts\":" << static_cast<long long>(startMs * 1000.0)
+            << ",\"dur\":" << static_cast<long long>(durationMs * 1000.0) << "}";
+    }
+}
+
+FlightRecorder::FlightRecorder(std::string directory) : directory(std::move(directory)) {}
+
+// Loading makes the intro's frames slow on purpose, so they never trigger
+void FlightRecorder::record(GameState state, const FrameStats& stats, float frameMs) {
+    samples[next] = Sample{clock.getElapsedTime().asMicroseconds() / 1000.0, frameMs, state, stats};
+    next = (next + 1) % CAPACITY;
+    if (filled < CAPACITY) ++filled;
+    if (sinceDump < CAPACITY) ++sinceDump;
+
+    if (frameMs > slowFrameMs && state != GameState::INTRO && sinceDump >= DUMP_SPACING) {
+        dump("slow frame " + std::to_string(static_cast<int>(frameMs + 0.5f)) + " ms");
+    }
+}
+
+// Each frame goes out as its render zone on one track, with poll and update
+// laid end to end before it on another, plus a counter sample. With the render
+// thread the update really ran beside the previous frame's drawing, so the
+// simulation track is placed by length, not measured start
+std::string FlightRecorder::dump(const std::string& reason) {
+    sinceDump = 0;
+    if (filled == 0) return {};
+
+    char stamp[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", std::localtime(&now));
+    std::string path = directory + "/trace-" + stamp + ".json";
+    for (int suffix = 1; std::filesystem::exists(path); ++suffix) {
+        path = directory + "/trace-" + stamp + "-" + std::to_string(suffix) + ".json";
+    }
+
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        std::cerr << "fail " << path << std::endl;
+        return {};
+    }
+
+    out << "{\"otherData\":{\"reason\":\"" << escape(reason) << "\"},\n\"traceEvents\":[\n"
+        << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"simulation\"}},\n"
+        << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"render\"}}";
+
+    const size_t first = (next + CAPACITY - filled) % CAPACITY;
+    for (size_t i = 0; i < filled; ++i) {
+        const Sample& sample = samples[(first + i) % CAPACITY];
+        const FrameStats& stats = sample.stats;
+        const double renderStart = sample.endMs - stats.renderMs;
+        const double updateStart = renderStart - stats.updateMs;
+
+        writeZone(out, "poll", 1, updateStart - stats.pollMs, stats.pollMs);
+        writeZone(out, "update", 1, updateStart, stats.updateMs);
+        writeZone(out, "render", 2, renderStart, stats.renderMs);
+        out << ",\n{\"name\":\"frame\",\"ph\":\"C\",\"pid\":1,\"ts\":"
+            << static_cast<long long>(renderStart * 1000.0)
+            << ",\"args\":{\"frame_ms\":" << sample.frameMs
+            << ",\"entities\":" << stats.entitiesTicked
+            << ",\"collision_queries\":" << stats.collisionQueries
+            << ",\"allocations\":" << stats.allocations
+            << ",\"draw_calls\":" << stats.drawCalls << "}}";
+        out << ",\n{\"name\":\"" << stateName(sample.state) << " " << inputString(stats.input)
+            << "\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":1,\"ts\":"
+            << static_cast<long long>(updateStart * 1000.0) << "}";
+    }
+    out << "\n]}\n";
+
+    if (!out) {
+        std::cerr << "fail " << path << std::endl;
+        return {};
+    }
+    std::cerr << "trace written to " << path << " (" << reason << ")" << std::endl;
+    return path;
+}
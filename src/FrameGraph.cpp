@@ -0,0 +1,149 @@
+#include "../include/FrameGraph.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+namespace {
+    constexpr float MARGIN = 20.0f;
+    constexpr float GRAPH_HEIGHT = 90.0f;
+    constexpr float GRAPH_MS = 33.3f;          // the top of the graph; taller frames are clipped
+    constexpr float TARGET_MS = 1000.0f / 60.0f;
+    constexpr float LINE_HEIGHT = 18.0f;
+    constexpr int TEXT_LINES = 3;
+
+    const sf::Color BACKGROUND(0, 0, 0, 160);
+    const sf::Color GUIDE(255, 255, 255, 90);
+    const sf::Color POLL_COLOR(90, 160, 255);
+    const sf::Color UPDATE_COLOR(90, 220, 120);
+    const sf::Color RENDER_COLOR(255, 170, 60);
+    const sf::Color TEXT_COLOR(235, 235, 235);
+
+    // SFML keeps a white 2x2 square in the top-left of every font page
+    const sf::Vector2f WHITE_TEXEL(1.0f, 1.0f);
+}
+
+// The printable ASCII range, without outlines
+bool FrameGraph::init(const sf::Font& font, sf::Vector2u windowSize) {
+    std::string printable;
+    for (char c = ' '; c <= '~'; ++c) {
+        printable += c;
+    }
+
+    if (!atlas.build(font, CHARACTER_SIZE, printable)) {
+        std::cerr << "fail frame graph atlas" << std::endl;
+        return false;
+    }
+
+    origin = sf::Vector2f(MARGIN, static_cast<float>(windowSize.y) - MARGIN - GRAPH_HEIGHT - TEXT_LINES * LINE_HEIGHT);
+    vertices.clear();
+    ready = true;
+    return true;
+}
+
+void FrameGraph::push(const FrameStats& stats) {
+    history[next] = stats;
+    next = (next + 1) % HISTORY;
+    filled = std::min(filled + 1, HISTORY);
+}
+
+// Rebuilt from the history every frame it is shown; the array keeps its
+// storage, so this neither allocates nor adds draw calls once warm
+void FrameGraph::render(sf::RenderTarget& target) {
+    if (!ready) return;
+    vertices.clear();
+
+    const float width = static_cast<float>(HISTORY);
+    addQuad({origin.x - 4.0f, origin.y - 4.0f}, {width + 8.0f, GRAPH_HEIGHT + TEXT_LINES * LINE_HEIGHT + 8.0f}, BACKGROUND);
+
+    const float scale = GRAPH_HEIGHT / GRAPH_MS;
+    const float bottom = origin.y + GRAPH_HEIGHT;
+    addQuad({origin.x, bottom - TARGET_MS * scale}, {width, 1.0f}, GUIDE);
+    addQuad({origin.x, origin.y}, {width, 1.0f}, GUIDE);
+
+    // Oldest on the left; each column is poll, update and render stacked
+    for (size_t i = 0; i < filled; ++i) {
+        const FrameStats& frame = history[(next + HISTORY - filled + i) % HISTORY];
+        const float x = origin.x + width - static_cast<float>(filled - i);
+        float top = bottom;
+        const float parts[3] = {frame.pollMs, frame.updateMs, frame.renderMs};
+        const sf::Color colors[3] = {POLL_COLOR, UPDATE_COLOR, RENDER_COLOR};
+        for (int part = 0; part < 3; ++part) {
+            const float height = std::min(parts[part] * scale, top - origin.y);
+            if (height <= 0.0f) break;
+            top -= height;
+            addQuad({x, top}, {1.0f, height}, colors[part]);
+        }
+    }
+
+    const FrameStats& last = history[(next + HISTORY - 1) % HISTORY];
+    char line[128];
+    sf::Vector2f pen(origin.x, bottom + LINE_HEIGHT);
+
+    std::snprintf(line, sizeof(line), "frame p50 %.2f ms  p99 %.2f ms  over %zu frames",
+                  percentile(0.50f), percentile(0.99f), filled);
+    addText(line, pen, TEXT_COLOR);
+    pen.y += LINE_HEIGHT;
+
+    std::snprintf(line, sizeof(line), "poll %.2f  ", last.pollMs);
+    pen.x = addText(line, pen, POLL_COLOR);
+    std::snprintf(line, sizeof(line), "update %.2f  ", last.updateMs);
+    pen.x = addText(line, pen, UPDATE_COLOR);
+    std::snprintf(line, sizeof(line), "render %.2f ms", last.renderMs);
+    addText(line, pen, RENDER_COLOR);
+    pen = sf::Vector2f(origin.x, pen.y + LINE_HEIGHT);
+
+    std::snprintf(line, sizeof(line), "draws %zu  entities %zu  collision queries %zu  allocations %zu",
+                  last.drawCalls, last.entitiesTicked, last.collisionQueries, last.allocations);
+    addText(line, pen, TEXT_COLOR);
+
+    target.draw(vertices, sf::RenderStates(&atlas.texture));
+}
+
+void FrameGraph::addQuad(sf::Vector2f position, sf::Vector2f size, sf::Color color) {
+    const sf::Vector2f corners[6] = {
+            position, {position.x + size.x, position.y}, {position.x, position.y + size.y},
+            {position.x, position.y + size.y}, {position.x + size.x, position.y}, position + size
+    };
+    for (const auto& corner : corners) {
+        vertices.append(sf::Vertex{corner, color, WHITE_TEXEL});
+    }
+}
+
+// pen is on the baseline; returns where the next character would go
+float FrameGraph::addText(const char* text, sf::Vector2f pen, sf::Color color) {
+    for (; *text; ++text) {
+        if (static_cast<unsigned char>(*text) >= atlas.glyphs.size()) continue;
+        const GlyphAtlas::Glyph& glyph = atlas[*text];
+        if (!glyph.loaded) {
+            pen.x += glyph.advance;
+            continue;
+        }
+
+        const sf::Vector2f topLeft = pen + glyph.fill.bounds.position;
+        const sf::Vector2f bottomRight = topLeft + glyph.fill.bounds.size;
+        const sf::Vector2f texTopLeft(glyph.fill.textureRect.position);
+        const sf::Vector2f texBottomRight = texTopLeft + sf::Vector2f(glyph.fill.textureRect.size);
+
+        vertices.append(sf::Vertex{topLeft, color, texTopLeft});
+        vertices.append(sf::Vertex{{bottomRight.x, topLeft.y}, color, {texBottomRight.x, texTopLeft.y}});
+        vertices.append(sf::Vertex{{topLeft.x, bottomRight.y}, color, {texTopLeft.x, texBottomRight.y}});
+        vertices.append(sf::Vertex{{topLeft.x, bottomRight.y}, color, {texTopLeft.x, texBottomRight.y}});
+        vertices.append(sf::Vertex{{bottomRight.x, topLeft.y}, color, {texBottomRight.x, texTopLeft.y}});
+        vertices.append(sf::Vertex{bottomRight, color, texBottomRight});
+        pen.x += glyph.advance;
+    }
+    return pen.x;
+}
+
+// Of the frame totals in the history, without touching the heap
+float FrameGraph::percentile(float fraction) {
+    if (filled == 0) return 0.0f;
+    for (size_t i = 0; i < filled; ++i) {
+        scratch[i] = history[i].pollMs + history[i].updateMs + history[i].renderMs;
+    }
+    const size_t rank = static_cast<size_t>(fraction * static_cast<float>(filled - 1) + 0.5f);
+    std::nth_element(scratch.begin(), scratch.begin() + static_cast<std::ptrdiff_t>(rank),
+                     scratch.begin() + static_cast<std::ptrdiff_t>(filled));
+    return scratch[rank];
+}
@@ -0,0 +1,25 @@
+#include "../include/FrozenFrame.h"
+#include <iostream>
+
+// Returns the texture to draw the frame into, or nullptr if it cannot be created
+sf::RenderTarget* FrozenFrame::beginCapture(const sf::Vector2u& size) {
+    if (texture.getSize() != size && !texture.resize(size)) {
+        std::cerr << "fail frozen frame " << size.x << "x" << size.y << std::endl;
+        return nullptr;
+    }
+    texture.setView(texture.getDefaultView());
+    texture.clear();
+    return &texture;
+}
+
+void FrozenFrame::endCapture() {
+    texture.display();
+    valid = true;
+}
+
+void FrozenFrame::render(sf::RenderTarget& target) const {
+    if (!valid) return;
+
+    target.setView(target.getDefaultView());
+    target.draw(sf::Sprite(texture.getTexture()));
+}
@@ -7,21 +7,98 @@
 #define PARALLAX_FACTOR 0.45f
 #define BG_SCALE 4.0f
 
+namespace {
+    struct LevelSound {
+        SoundEffect effect;
+        const char* name;
+        const char* path;
+        int priority;
+        float cooldown;
+    };
+    const LevelSound LEVEL_SOUNDS[] = {
+            {SoundEffect::JUMP, "jump", "./assets/jump.mp3", 3, 0.05f},
+            {SoundEffect::BUMPER, "bumper", "./assets/bumper.mp3", 2, 0.05f},
+            {SoundEffect::RING_COLLECT, "ring-collect", "./assets/ring-collect.mp3", 1, 0.03f},
+            {SoundEffect::BADNIK_DEATH, "badnik-death", "./assets/badnik-death.mp3", 2, 0.0f},
+            {SoundEffect::RING_LOSS, "ring-loss", "./assets/ring-loss.mp3", 3, 0.5f},
+            {SoundEffect::DEATH, "death", "./assets/death.mp3", 4, 1.0f}
+    };
+    constexpr float UPLOAD_BUDGET_MS = 4.0f;
+    const char* const ASSET_PACK = "./assets.pak";   // loose files under ./assets are used without it
+    constexpr size_t BADNIK_GRAIN = 64;   // badniks per job; a normal level stays on one thread
+
+    PlayerInput readKeyboard() {
+        PlayerInput input;
+        input.left = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A);
+        input.right = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D);
+        input.up = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W);
+        input.down = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::S);
+        input.jump = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Space);
+        return input;
+    }
+
+    // Runs step on every live pointer in sprites, spread over the job system
+    template <typename T, typename Step>
+    void forEachParallel(JobSystem& jobs, const std::vector<T*>& sprites, Step step) {
+        jobs.parallelFor(sprites.size(), BADNIK_GRAIN, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (sprites[i]) step(*sprites[i]);
+            }
+        });
+    }
 
-GameEngine::GameEngine() : window(nullptr), videoMode(), currentState(GameState::INTRO),
-                           isPaused(false), pauseTime(0), map(nullptr), bgr(nullptr), collision(nullptr),
-                           player(nullptr), musicVolume(50.0f), isMusicMuted(false), stateManager(nullptr),
-                           isGodMode(false), ringCountText(nullptr) {
+    // Fills contacts[i] for every live badnik, in parallel; dead and null ones get none
+    template <typename T, typename Test>
+    void gatherContacts(JobSystem& jobs, const std::vector<T*>& sprites,
+                        std::vector<GameEngine::BadnikContact>& contacts, Test test) {
+        contacts.assign(sprites.size(), GameEngine::BadnikContact());
+        jobs.parallelFor(sprites.size(), BADNIK_GRAIN, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (sprites[i] && sprites[i]->isAlive()) contacts[i] = test(*sprites[i]);
+            }
+        });
+    }
+}
+
+
+GameEngine::GameEngine(StartupTimeline* startup)
+        : window(nullptr), videoMode(), currentState(GameState::INTRO),
+          isPaused(false), pauseTime(0), startup(startup), map(nullptr), bgr(nullptr), collision(nullptr),
+          player(nullptr), musicVolume(50.0f), isMusicMuted(false), stateManager(nullptr),
+          isGodMode(false) {
     try {
-        std::srand(static_cast<unsigned>(std::time(nullptr)));
+        random.reseed(static_cast<uint64_t>(std::time(nullptr)));
+        context.random = &random;
 
-        initGameElements();
-        storeInitialEnemyPositions();
+        {
+            StartupTimeline::Scope scope(startup, "asset pack");
+            if (pack.open(ASSET_PACK)) {
+                AssetPack::mount(&pack);
+            }
+        }
+        {
+            StartupTimeline::Scope scope(startup, "initWindow");
+            initWindow();
+        }
         if (!window) throw std::runtime_error("fail");
-        stateManager = new GameStateManager(window, bgMusic, musicVolume, isMusicMuted, isGodMode, isGridMapVisible);
+        initMetrics();
+        {
+            StartupTimeline::Scope scope(startup, "SoundManager()");
+            sounds = std::make_unique<SoundManager>();
+        }
+        sounds->setPlayCounter(soundsPlayed);
+        context.sounds = sounds.get();
+        {
+            StartupTimeline::Scope scope(startup, "GameStateManager()");
+            stateManager = new GameStateManager(window, bgMusic, *sounds, musicVolume, isMusicMuted, isGodMode, isGridMapVisible, isFrameGraphVisible, isPixelPerfect);
+        }
 
 
         stateManager->setEngineReference(this);
+        assets = std::make_shared<AssetLoader>();
+        assets->setSounds(sounds.get());
+        assets->setTimeline(startup);
+        queueLevelAssets();
 
     }
     catch (const std::exception& e) {
@@ -33,53 +110,55 @@ GameEngine::GameEngine() : window(nullptr), videoMode(), currentState(GameState:
 
 }
 
+// A windowless engine for bots and test runs, built on a level loaded once by
+// loadHeadlessLevel() and shared with every other headless engine. It has no
+// menus, music, HUD or render thread, starts straight in PLAYING and only moves
+// when step() is called. Its job system runs inline: the caller parallelises
+// over engines instead
+GameEngine::GameEngine(std::shared_ptr<const LevelData> sharedLevel)
+        : jobs(0), level(std::move(sharedLevel)), headless(true) {
+    try {
+        if (!level) throw std::runtime_error("fail level");
+        context.level = level.get();
+        context.random = &random;
+        initMetrics();
+        initViews();
+        initGameElements();
+        levelLoaded = true;
+        currentState = GameState::PLAYING;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "fail " << e.what() << std::endl;
+        cleanup();
+        throw;
+    }
+}
+
 GameEngine::~GameEngine() {
     cleanup();
 }
 
+// The render thread draws with the window, state manager and HUD, so it is
+// joined before any of them go
 void GameEngine::cleanup() {
-    for (auto* flower : flowerSprites) delete flower;
-    flowerSprites.clear();
-
-    for (auto* bridge : bridgeSprites) delete bridge;
-    bridgeSprites.clear();
+    pipeline.stop();
 
     for (auto* checkpoint : checkpointSprites) delete checkpoint;
     checkpointSprites.clear();
 
-    for (auto* buzzer : buzzerEnemies) delete buzzer;
-    buzzerEnemies.clear();
-
-    for (auto* ring : ringSprites) delete ring;
-    ringSprites.clear();
-
-    for (auto* crabmeat : crabmeatEnemies) delete crabmeat;
-    crabmeatEnemies.clear();
-
-    for (auto* motobug : motobugEnemies) delete motobug;
-    motobugEnemies.clear();
+    clearBadniks();
+    ringField.clear();
 
     for (auto* spike : spikeSprites) delete spike;
     spikeSprites.clear();
 
-    for (auto* fish : fishEnemies) delete fish;
-    fishEnemies.clear();
-
-    for (auto* powerUp : powerUpSprites) {
-        delete powerUp;
-    }
-    powerUpSprites.clear();
+    clearPowerUps();
 
     for (auto* spring : springSprites) {
         delete spring;
     }
     springSprites.clear();
 
-    for (auto* powerUp : powerUpSprites) {
-        delete powerUp;
-    }
-    powerUpSprites.clear();
-
 
     scatteredRings.clear();
 
@@ -98,24 +177,121 @@ void GameEngine::cleanup() {
     collision = nullptr;
     player = nullptr;
     stateManager = nullptr;
+    AssetPack::unmount(&pack);
 }
 
-//function to initialize the game elements
-void GameEngine::initGameElements() {
+//function to open the window and set up the views; all the intro needs
+void GameEngine::initWindow() {
     videoMode = sf::VideoMode(sf::Vector2u(800, 600));
     window = new sf::RenderWindow(videoMode, "HY454 - Sonic", sf::Style::Titlebar | sf::Style::Close);
     window->setFramerateLimit(60);
+    initViews();
+}
 
+void GameEngine::initViews() {
     view.setSize(sf::Vector2f{1.4f * TILE_SIZE, 1.0f * TILE_SIZE});
     view.setCenter(sf::Vector2f{view.getSize().x / 2.0f, 3.0f * view.getSize().y});
 
     bgr_view = view;
     bgr_view.setSize(sf::Vector2f{view.getSize().x * BG_SCALE, view.getSize().y * BG_SCALE});
     bgr_view.setCenter(sf::Vector2f{BG_SCALE * view.getCenter().x, BG_SCALE * view.getSize().y / 2.0f});
+}
+
+// Registers this engine's instruments; whatever holds one gets a pointer that
+// stays valid for the engine's lifetime
+void GameEngine::initMetrics() {
+    collisionQueries = &metrics.counter("collision_queries", "Collision map queries");
+    tilesDrawn = &metrics.counter("tiles_drawn", "Map and background tiles recorded for drawing");
+    spritesDrawn = &metrics.counter("sprites_drawn", "Sprite, ring and particle quads recorded for drawing");
+    entitiesActive = &metrics.gauge("entities_active", "Entities ticked by the last step");
+    soundsPlayed = &metrics.counter("sounds_played", "Sound effects started");
+    bytesAllocated = &metrics.counter("bytes_allocated", "Bytes requested from operator new, any thread");
+    frameMs = &metrics.histogram("frame_ms", "Time between drawn frames in milliseconds",
+                                 {4.0, 8.0, 12.0, 16.7, 20.0, 25.0, 33.3, 50.0, 100.0});
+}
+
+
+// Hands the level's images, map tables and uncached sounds to the loader's
+// workers; the intro keeps drawing while they decode
+void GameEngine::queueLevelAssets() {
+    StartupTimeline::Scope scope(startup, "queueLevelAssets");
+    LevelData::queueAssets(*assets);
+
+    for (const auto& sound : LEVEL_SOUNDS) {
+        StartupTimeline::Scope soundScope(startup, sound.name);
+        if (sounds->loadCached(sound.name, sound.path) == NO_SOUND) {
+            assets->queueSound(sound.name, sound.path);
+        }
+    }
+    assets->start();
+}
+
+// Every level sound is registered by now; this resolves each effect to its id
+// and sets how often it may restart
+void GameEngine::initSounds() {
+    StartupTimeline::Scope scope(startup, "initSounds");
+    for (const auto& sound : LEVEL_SOUNDS) {
+        StartupTimeline::Scope soundScope(startup, sound.name);
+        context.effects[static_cast<size_t>(sound.effect)] =
+                sounds->loadSound(sound.name, sound.path, sound.priority, sound.cooldown);
+    }
+    sounds->saveCache();
+}
+
+// Maps the pack and loads the level without decoding or uploading any pixels,
+// for engines built with the headless constructor. Blocks until the loader's
+// workers are done
+std::shared_ptr<const LevelData> GameEngine::loadHeadlessLevel(AssetPack& sharedPack) {
+    if (sharedPack.open(ASSET_PACK)) {
+        AssetPack::mount(&sharedPack);
+    }
 
-    bgr = new GameMap(64, 64, 0, 0, "./assets/background_foreground64.png", "./assets/background.csv");
-    map = new GameMap(256, 256, 8, 8, "./assets/Map_Tilesheet.png", "./assets/Map.csv");
-    collision = new GameMap(2, 2, 0, 0, "./assets/grid_tile_set.png", "./assets/basic_gridmap.csv");
+    auto loader = std::make_shared<AssetLoader>();
+    loader->setHeadless(true);
+    LevelData::queueAssets(*loader);
+    loader->start();
+
+    while (!loader->isDone()) {
+        loader->pump(UPLOAD_BUDGET_MS);
+        sf::sleep(sf::milliseconds(1));
+    }
+    return LevelData::load(loader);
+}
+
+// Called every intro frame until the level is built
+void GameEngine::updateLoading() {
+    assets->pump(UPLOAD_BUDGET_MS);
+    if (stateManager) stateManager->setLoadProgress(assets->progress());
+
+    if (assets->isDone()) {
+        StartupTimeline::Scope scope(startup, "level build");
+        {
+            StartupTimeline::Scope loadScope(startup, "LevelData::load");
+            level = LevelData::load(assets);
+        }
+        context.level = level.get();
+        initSounds();
+        initGameElements();
+        levelLoaded = true;
+    }
+}
+
+//function to build this engine's world from the shared level data
+void GameEngine::initGameElements() {
+    StartupTimeline::Scope scope(startup, "initGameElements");
+    {
+        StartupTimeline::Scope mapScope(startup, "GameMap background");
+        bgr = new GameMap(level->background);
+    }
+    {
+        StartupTimeline::Scope mapScope(startup, "GameMap foreground");
+        map = new GameMap(level->foreground);
+    }
+    {
+        StartupTimeline::Scope mapScope(startup, "GameMap collision");
+        collision = new GameMap(level->collision);
+    }
+    collision->setQueryCounter(collisionQueries);
 
     auto mapSizeX = map->getMapWidth() * 256.0f;
     auto mapSizeY = map->getMapHeight() * 256.0f;
@@ -127,197 +303,109 @@ void GameEngine::initGameElements() {
     minBgrViewBounds = sf::Vector2f{bgr_view.getSize().x / 2.0f, bgr_view.getSize().y / 2.0f};
     bgrViewBounds = sf::Vector2f{bgrMapSizeX - bgr_view.getSize().x / 2.0f, bgrMapSizeY - bgr_view.getSize().y / 2.0f};
 
-    player = new Player();
+    player = new Player(*level->playerSheet, context);
     player->setEngineRef(this);
-    player->setPosition(179.2f, 919.0f);
+    player->setPosition(level->playerStart);
     player->setCollisionMap(collision);
 
-    if (!bgMusic.openFromFile("./assets/greenhill.mp3")) {
-        throw std::runtime_error("fail");
+    {
+        StartupTimeline::Scope sceneryScope(startup, "scenery");
+        for (const auto& piece : level->scenery) {
+            addDecoration(piece.kind, piece.position);
+        }
     }
-    bgMusic.setLooping(true);
-    bgMusic.setVolume(musicVolume);
-
-    initFlowerSprites();
-
-    initPowerUpSprites();
-
-
-    BridgeSprite::createBridgeGroup(bridgeSprites, 272 * 4, 224 * 4, 12);
-    BridgeSprite::createBridgeGroup(bridgeSprites, 656 * 4, 196 * 4, 12);
-    BridgeSprite::createBridgeGroup(bridgeSprites, 2000 * 4, 196 * 4, 12);
-
-    RingSprite::createRingGroup(ringSprites, 79 * 4, 216 * 4, 3);
-
-    RingSprite::createRingGroup(ringSprites, 281 * 4, 198 * 4, 6);
-    RingSprite::createRingGroup(ringSprites, 622 * 4, 174 * 4, 2);
-    RingSprite::createRingGroup(ringSprites, 735 * 4, 176 * 4, 2);
-    RingSprite::createRingGroup(ringSprites, 1108 * 4, 201 * 4, 3);
-    RingSprite::createRingGroup(ringSprites, 1157 * 4, 201 * 4, 3);
-    RingSprite::createRingGroup(ringSprites, 1617 * 4, 217 * 4, 5);
-    RingSprite::createRingGroup(ringSprites, 2006 * 4, 282 * 4, 6);
-
-    ringSprites.push_back(new RingSprite(sf::Vector2f(3400, 686)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(3432, 673)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(3466, 655)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(3500, 639)));
-
-
-    ringSprites.push_back(new RingSprite(sf::Vector2f(3858, 509)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(3895, 513)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(3934, 512)));
-
-
-    ringSprites.push_back(new RingSprite(sf::Vector2f(4692, 566)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(4728, 577)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(4762, 593)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(4795, 609)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(4834, 617)));
-
-    ringSprites.push_back(new RingSprite(sf::Vector2f(1656 , 895)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(1688 , 911)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(1720 , 925)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(1755 , 936)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(1795 , 939)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(1839 , 935)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(1875 , 906)));
-
-    ringSprites.push_back(new RingSprite(sf::Vector2f(5852, 429)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(5892, 429)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(5932, 419)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(5971, 404)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(6012, 385)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(6046, 369)));
-
-
-    ringSprites.push_back(new RingSprite(sf::Vector2f(6104, 364)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(6148, 364)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(6196, 366)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(6244, 368)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(6292, 370)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(6340, 634)));
-
-
-    ringSprites.push_back(new RingSprite(sf::Vector2f(6388, 635)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(6436, 635)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(6484, 370)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(6532, 371)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(6580, 366)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(6628, 364)));
-
-
-    ringSprites.push_back(new RingSprite(sf::Vector2f(9018, 1133)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(9055, 1142)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(9086, 1157)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(9117, 1193)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(9150, 1190)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(9188, 1198)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(9228, 1198)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(9266, 1198)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(9305, 1198)));
-    ringSprites.push_back(new RingSprite(sf::Vector2f(9342, 1198)));
-
-    std::vector<sf::Vector2f> spikePositions = {
-            sf::Vector2f(835 * 4, 216 * 4),
-            sf::Vector2f(847 * 4, 218 * 4),
-            sf::Vector2f(860 * 4, 218 * 4),
-            sf::Vector2f(881 * 4, 216 * 4),
-            sf::Vector2f(977 * 4, 233 * 4),
-            sf::Vector2f(997 * 4, 234 * 4),
-            sf::Vector2f(1110 * 4, 218 * 4),
-            sf::Vector2f(1136 * 4, 216 * 4),
-            sf::Vector2f(1160 * 4, 217 * 4),
-            sf::Vector2f(1325 * 4, 201 * 4),
-            sf::Vector2f(1338 * 4, 200 * 4),
-            sf::Vector2f(1351 * 4, 200 * 4),
-            sf::Vector2f(1923 * 4, 297 * 4),
-            sf::Vector2f(2051 * 4, 296 * 4)
-    };
-    SpikeSprite::createSpikeGroup(spikeSprites, spikePositions);
 
-    std::vector<sf::Vector2f> checkpointPositions = {
-            sf::Vector2f(1626 * 4, 210 * 4),
-            sf::Vector2f(1140 * 4, 128 * 4)
-    };
-
-    CheckpointSprite::createCheckpointGroup(checkpointSprites, checkpointPositions);
+    particles.setArchetypes(level->archetypes);
+    ringField.setParticles(&particles);
+    ringField.setArchetype(level->archetypes.get(SpriteKind::RING));
+    for (const auto& group : level->ringGroups) {
+        ringField.addRingGroup(group.startX, group.startY, group.count);
+    }
+    for (const auto& pos : level->rings) {
+        ringField.addRing(pos);
+    }
 
-    std::vector<sf::Vector2f> buzzerPositions = {
-            sf::Vector2f(264 * 4, 195 * 4),
-            sf::Vector2f(845 * 4, 142 * 4),
-            sf::Vector2f(882 * 4, 146 * 4),
-            sf::Vector2f(1092 * 4, 117 * 4),
-            sf::Vector2f(1896 * 4, 190 * 4),
-            sf::Vector2f(1952 * 4, 164 * 4),
-            sf::Vector2f(2291 * 4, 218 * 4)
-    };
+    SpikeSprite::createSpikeGroup(spikeSprites, level->spikes, level->archetypes);
+    CheckpointSprite::createCheckpointGroup(checkpointSprites, level->checkpoints, level->archetypes);
+    PlatformSprite::createPlatformGroup(platformSprites, level->platforms, level->archetypes);
+    SpringSprite::createSpringGroup(springSprites, level->springs, level->archetypes);
 
-    std::vector<sf::Vector2f> platformPositions = {
-            sf::Vector2f(4546.0f, 479.0f),
-            sf::Vector2f(4738.0f, 415.0f),
-            sf::Vector2f(4994.0f, 383.0f),
-            sf::Vector2f(5122.0f, 415.0f),
-            sf::Vector2f(5250.0f, 447.0f),
-            sf::Vector2f(5630.0f, 434.0f)
-    };
-
-    PlatformSprite::createPlatformGroup(platformSprites, platformPositions);
+    {
+        StartupTimeline::Scope badnikScope(startup, "spawnBadniks");
+        spawnBadniks();
+    }
+    {
+        StartupTimeline::Scope powerUpScope(startup, "spawnPowerUps");
+        spawnPowerUps();
+    }
 
-    std::vector<sf::Vector2f> springPositions = {
-            sf::Vector2f(3488.0f, 883.0f),
-            sf::Vector2f(3612.0f, 624.0f),
-            sf::Vector2f(3952.0f, 951.0f)
-    };
+    // Music, font and HUD are for the window only
+    if (headless) {
+        return;
+    }
 
-    SpringSprite::createSpringGroup(springSprites, springPositions);
+    StartupTimeline::Scope windowScope(startup, "music, font and HUD");
+    if (!AssetPack::load("./assets/greenhill.mp3", bgMusic)) {
+        throw std::runtime_error("fail");
+    }
+    bgMusic.setLooping(true);
+    bgMusic.setVolume(musicVolume);
 
+    if (!AssetPack::load("./assets/Arial.ttf", gameFont)) {
+        throw std::runtime_error("fail");
+    }
 
+    initHud();
+}
 
-    for (const auto& pos : buzzerPositions) {
-        buzzerEnemies.push_back(new BuzzerEnemy(pos));}
 
-    std::vector<sf::Vector2f> motobugPositions = {
-            sf::Vector2f(208 * 4, 232 * 4),
-            sf::Vector2f(1302 * 4, 190 * 4)
-    };
+// Badniks are killed and deleted in play, so a restart builds them again from
+// the level's spawn layout
+void GameEngine::spawnBadniks() {
+    for (const auto& pos : level->buzzers) {
+        auto* buzzer = new BuzzerEnemy(level->archetypes, pos);
+        buzzer->setCollisionMap(collision);
+        buzzerEnemies.push_back(buzzer);
+    }
 
-    for (const auto& pos : motobugPositions) {
-        auto* motobug = new MotobugEnemy(pos);
+    for (const auto& pos : level->motobugs) {
+        auto* motobug = new MotobugEnemy(level->archetypes, pos);
         motobug->setCollisionMap(collision);
         motobugEnemies.push_back(motobug);
     }
 
-    std::vector<sf::Vector2f> crabmeatPositions = {
-            sf::Vector2f(548 * 4, 208 * 4),
-            sf::Vector2f(558 * 4, 200 * 4),
-            sf::Vector2f(2142 * 4, 287 * 4)
-    };
-
-    for (const auto& pos : crabmeatPositions) {
-        auto* crabmeat = new CrabmeatEnemy(pos);
+    for (const auto& pos : level->crabmeats) {
+        auto* crabmeat = new CrabmeatEnemy(level->archetypes, pos);
         crabmeat->setCollisionMap(collision);
         crabmeatEnemies.push_back(crabmeat);
     }
 
-    auto* crabmeat1 = new CrabmeatEnemy(sf::Vector2f(5370, 480));
-    crabmeat1->setCollisionMap(collision);
-    crabmeatEnemies.push_back(crabmeat1);
+    for (const auto& spawn : level->fish) {
+        auto* fish = new FishEnemy(level->archetypes, spawn.position, spawn.targetY);
+        fish->setCollisionMap(collision);
+        fishEnemies.push_back(fish);
+    }
 
+    storeInitialEnemyPositions();
+}
 
-    platformSprites.push_back(new PlatformSprite(sf::Vector2f(2322*2, 223*2)));
+void GameEngine::clearBadniks() {
+    for (auto* buzzer : buzzerEnemies) delete buzzer;
+    buzzerEnemies.clear();
 
-    fishEnemies.push_back(new FishEnemy(sf::Vector2f(295 * 4, 190 * 4), 265));
-    fishEnemies.push_back(new FishEnemy(sf::Vector2f(669 * 4, 164 * 4), 225));
-    fishEnemies.push_back(new FishEnemy(sf::Vector2f(690 * 4, 164 * 4), 238));
-    fishEnemies.push_back(new FishEnemy(sf::Vector2f(2018 * 4, 164 * 4), 240));
-    fishEnemies.push_back(new FishEnemy(sf::Vector2f(2031 * 4, 164 * 4), 243));
+    for (auto* crabmeat : crabmeatEnemies) delete crabmeat;
+    crabmeatEnemies.clear();
 
+    for (auto* motobug : motobugEnemies) delete motobug;
+    motobugEnemies.clear();
 
-    if (!gameFont.openFromFile("./assets/arial.ttf")) {
-        throw std::runtime_error("fail");
-    }
+    for (auto* fish : fishEnemies) delete fish;
+    fishEnemies.clear();
 
-    initText();
+    buzzerInitialStates.clear();
+    motobugInitialStates.clear();
+    crabmeatInitialStates.clear();
+    fishInitialStates.clear();
 }
 
 
@@ -325,7 +413,7 @@ void GameEngine::initGameElements() {
 
 void GameEngine::CreateScatteredRing(const sf::Vector2f& position, const sf::Vector2f& velocity) {
     try {
-        scatteredRings.push_back(ScatteredRing(position, velocity));
+        scatteredRings.push_back(ScatteredRing(level->archetypes, position, velocity));
 
 
     }
@@ -335,26 +423,29 @@ void GameEngine::CreateScatteredRing(const sf::Vector2f& position, const sf::Vec
 }
 
 
-GameEngine::ScatteredRing::ScatteredRing(const sf::Vector2f& pos, const sf::Vector2f& vel)
+GameEngine::ScatteredRing::ScatteredRing(const SpriteArchetypes& types, const sf::Vector2f& pos, const sf::Vector2f& vel)
         : velocity(vel)
         , lifetime(0.0f)
         , floorTime(0.0f)
         , active(true)
         , onFloor(false)
 {
-    sprite = std::make_unique<RingSprite>(pos);
+    sprite = std::make_unique<RingSprite>(types, pos);
 }
 
-void GameEngine::initPowerUpSprites() {
-    powerUpSprites.push_back(new PowerUpSprite(sf::Vector2f(144.0f * 4, 208.0f * 4), PowerUpSprite::PowerUpType::SPEED));
-    powerUpSprites.push_back(new PowerUpSprite(sf::Vector2f(369.0f * 4, 196.0f * 4), PowerUpSprite::PowerUpType::HEALTH));
-    powerUpSprites.push_back(new PowerUpSprite(sf::Vector2f(1196.0f * 4, 200.0f * 4), PowerUpSprite::PowerUpType::SHIELD));
-    powerUpSprites.push_back(new PowerUpSprite(sf::Vector2f(2188.0f * 4, 208.0f * 4), PowerUpSprite::PowerUpType::RINGS));
-    powerUpSprites.push_back(new PowerUpSprite(sf::Vector2f(2249.0f * 4, 196.0f * 4), PowerUpSprite::PowerUpType::INVINCIBILITY));
+void GameEngine::spawnPowerUps() {
+    for (const auto& spawn : level->powerUps) {
+        auto* powerUp = new PowerUpSprite(level->archetypes, spawn.position, spawn.type);
+        powerUp->setEngineRef(this);
+        powerUpSprites.push_back(powerUp);
+    }
+}
 
+void GameEngine::clearPowerUps() {
     for (auto* powerUp : powerUpSprites) {
-        powerUp->setEngineRef(this);
+        delete powerUp;
     }
+    powerUpSprites.clear();
 }
 
 
@@ -366,7 +457,6 @@ void GameEngine::handlePowerUpEffect(PowerUpSprite::PowerUpType type) {
             for (int i = 0; i < 10; i++) {
                 player->addRing();
             }
-            updateRingDisplay();
             break;
 
         case PowerUpSprite::PowerUpType::INVINCIBILITY:
@@ -383,92 +473,25 @@ void GameEngine::handlePowerUpEffect(PowerUpSprite::PowerUpType type) {
 
         case PowerUpSprite::PowerUpType::HEALTH:
             increasePlayerLives(1);
-            updateLivesDisplay();
             break;
     }
 }
 
 
 
-void GameEngine::initFlowerSprites() {
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(0.0f, 880.0f)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(256.0f, 880.0f)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(512.0f, 880.0f)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(608.0f, 800.0f)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(768.0f, 880.0f)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(1408.0f, 832.0f)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(1792.0f, 880.0f)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(548.0f * 4, 200.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(768.0f * 4, 156.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(832.0f * 4, 156.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(1008.0f * 4, 146.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(1016.0f * 4, 140.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(1028.0f * 4, 216.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(1124.0f * 4, 136.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(1164.0f * 4, 130.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(1280.0f * 4, 156.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(1412.0f * 4, 152.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(1476.0f * 4, 88.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(1536.0f * 4, 12.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(1560.0f * 4, 16.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(1600.0f * 4, 12.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(1624.0f * 4, 16.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(1664.0f * 4, 12.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(1688.0f * 4, 16.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(1792.0f * 4, 284.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(1888.0f * 4, 208.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(2096.0f * 4, 208.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(2104.0f * 4, 204.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(2176.0f * 4, 220.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(2200.0f * 4, 200.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(2304.0f * 4, 284.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(2368.0f * 4, 284.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(2432.0f * 4, 284.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(false, sf::Vector2f(2496.0f * 4, 284.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(64.0f, 904.0f)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(96.0f, 904.0f)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(320.0f, 904.0f)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(352.0f, 904.0f)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(1312.0f, 840.0f)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(1344.0f, 840.0f)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(1440.0f, 840.0f)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(2080.0f, 840.0f)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(784.0f * 4, 162.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(792.0f * 4, 162.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(912.0f * 4, 210.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(948.0f * 4, 226.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(1096.0f * 4, 146.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(1232.0f * 4, 146.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(1268.0f * 4, 162.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(1296.0f * 4, 162.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(1304.0f * 4, 162.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(1552.0f * 4, 18.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(1576.0f * 4, 18.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(1588.0f * 4, 18.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(1616.0f * 4, 18.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(1640.0f * 4, 18.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(1652.0f * 4, 18.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(1680.0f * 4, 18.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(1704.0f * 4, 18.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(1716.0f * 4, 18.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(1744.0f * 4, 274.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(1780.0f * 4, 290.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(1824.0f * 4, 210.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(1872.0f * 4, 210.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(1896.0f * 4, 210.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(2256.0f * 4, 274.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(2292.0f * 4, 290.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(2320.0f * 4, 290.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(2328.0f * 4, 290.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(2384.0f * 4, 290.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(2392.0f * 4, 290.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(2448.0f * 4, 290.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(2456.0f * 4, 290.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(2512.0f * 4, 290.0f * 4)));
-    flowerSprites.push_back(new FlowerSprite(true, sf::Vector2f(2520.0f * 4, 290.0f * 4)));
+// Bakes a sprite type's current frame (or its whole clip, if animated) into the
+// map's decoration layer; used for scenery that never moves or collides
+void GameEngine::addDecoration(SpriteKind kind, const sf::Vector2f& pos) {
+    const auto& type = level->archetypes.get(kind);
+    if (type.animated) {
+        map->getDecorations().add(*type.texture, *type.clip, pos);
+    } else {
+        map->getDecorations().add(*type.texture, type.clip->frames[0].rect, pos);
+    }
 }
 
 
+
 void GameEngine::updateScatteredRings(float deltaTime) {
     const float RING_GRAVITY = 0.3f;
     const float RING_BOUNCE = -0.5f;
@@ -493,9 +516,10 @@ void GameEngine::updateScatteredRings(float deltaTime) {
         it->updateLifetime(deltaTime);
 
         if (canCollect && it->getLifetime() > COLLECTION_DELAY && it->isActive()) {
-            if (playerBounds.findIntersection(it->getSprite()->getBounds())) {
+            sf::FloatRect ringBounds = it->getSprite()->getBounds();
+            if (playerBounds.findIntersection(ringBounds)) {
+                particles.emit(ParticleEffect::RING_SPARKLE, ringBounds.getCenter());
                 player->addRing();
-                updateRingDisplay();
                 it = scatteredRings.erase(it);
                 continue;
             }
@@ -541,70 +565,28 @@ void GameEngine::updateScatteredRings(float deltaTime) {
             it->getSprite()->setPosition(newPos);
         }
 
-        it->getSprite()->update(deltaTime);
+        it->getSprite()->advanceAnimation(deltaTime);
         ++it;
     }
 }
 
 
 
-void GameEngine::renderScatteredRings() {
-    if (!window) return;
-
-    for (const auto& ring : scatteredRings) {
-        if (ring.isActive() && ring.getSprite()) {
-            ring.getSprite()->render(*window);
-        }
-    }
+void GameEngine::addScore(int points) {
+    score += points;
 }
 
-
-
-void GameEngine::updateRingDisplay() {
-    if (player && ringCountText) {
-        std::string ringStr = "RINGS: " + std::to_string(player->getRingCount());
-        ringCountText->setString(ringStr);
-
-        auto windowSize = window->getSize();
-        ringCountText->setPosition(sf::Vector2f(20.f, 20.f));
-
-        ringCountText->setCharacterSize(24);
-        ringCountText->setFillColor(sf::Color(255, 215, 0));
-        ringCountText->setOutlineColor(sf::Color::Black);
-        ringCountText->setOutlineThickness(1.0f);
-    }
-}
-
-void GameEngine::initText() {
-    if (ringCountText == nullptr) {
-        ringCountText = new sf::Text(gameFont, "RINGS: 0", 24);
-        ringCountText->setFillColor(sf::Color(255, 215, 0));
-        ringCountText->setOutlineColor(sf::Color::Black);
-        ringCountText->setOutlineThickness(1.0f);
-        ringCountText->setPosition(sf::Vector2f(20.f, 20.f));
-    }
-
-    if (livesCountText == nullptr) {
-        livesCountText = new sf::Text(gameFont, "LIVES: " + std::to_string(currentLives), 24);
-        livesCountText->setFillColor(sf::Color(255, 100, 100));
-        livesCountText->setOutlineColor(sf::Color::Black);
-        livesCountText->setOutlineThickness(1.0f);
-        livesCountText->setPosition(sf::Vector2f(20.f, 50.f));
+void GameEngine::initHud() {
+    if (!hud.init(gameFont, window->getSize()) || !frameGraph.init(gameFont, window->getSize())) {
+        throw std::runtime_error("fail");
     }
 }
 
 
 
-void GameEngine::updateLivesDisplay() {
-    if (livesCountText) {
-        livesCountText->setString("LIVES: " + std::to_string(currentLives));
-    }
-}
-
 void GameEngine::handlePlayerDeath() {
     if (currentLives > 0) {
         currentLives--;
-        updateLivesDisplay();
         respawnPlayer();
     } else {
         SetCurrentState(GameState::GAME_OVER);
@@ -671,7 +653,7 @@ void GameEngine::poll() {
 
         if (event->is<sf::Event::Closed>()) {
 
-            window->close();
+            close();
 
             return;
 
@@ -697,6 +679,12 @@ void GameEngine::poll() {
 
             }
 
+            else if (keyPressed->scancode == sf::Keyboard::Scancode::F3 && stateManager) {
+
+                stateManager->toggleFrameGraph();
+
+            }
+
         }
 
         else if (const auto* mouseClick = event->getIf<sf::Event::MouseButtonPressed>()) {
@@ -704,6 +692,7 @@ void GameEngine::poll() {
             if (mouseClick->button == sf::Mouse::Button::Left && isPaused) {
 
                 stateManager->handlePauseMenuClick(mouseClick->position.x, mouseClick->position.y);
+                ++worldRevision;   // grid map / pixel perfect may have changed
 
             }
 
@@ -734,22 +723,27 @@ void GameEngine::poll() {
 }
 
 
-// Main update function that handles game state and logic updates
+// Main update function that handles game state and logic updates, then hands
+// the frame to the renderer
 void GameEngine::update() {
     try {
+        sf::Clock phaseClock;
         poll();
-
-        static GameState lastState = currentState;
-        if (lastState != currentState) {
-            lastState = currentState;
+        if (!window->isOpen()) {
+            return;
         }
+        const float pollMs = phaseClock.restart().asSeconds() * 1000.0f;
 
         switch (currentState) {
             case GameState::INTRO:
+                if (!levelLoaded) {
+                    updateLoading();
+                }
                 if (stateManager) {
                     stateManager->updateIntroScreen();
-                    if (stateManager->isIntroFadeComplete()) {
+                    if (levelLoaded && stateManager->isIntroFadeComplete()) {
                         currentState = GameState::PLAYING;
+                        stepClock.restart();
                         if (!isMusicMuted && bgMusic.getStatus() != sf::Music::Status::Playing) {
                             bgMusic.play();
                         }
@@ -759,7 +753,7 @@ void GameEngine::update() {
 
             case GameState::PLAYING:
                 if (!isPaused) {
-                    updateGameState();
+                    step(readKeyboard(), stepClock.restart().asSeconds());
                 }
                 break;
 
@@ -779,6 +773,30 @@ void GameEngine::update() {
                 }
                 break;
         }
+
+        if (window->isOpen()) {
+            RenderSnapshot& frame = pipeline.back();
+            recordFrame(frame);
+
+            const size_t allocations = AllocationCounter::total();
+            const size_t allocatedBytes = AllocationCounter::bytes();
+            const uint64_t queries = collisionQueries->get();
+            frame.stats = FrameStats{};
+            frame.stats.pollMs = pollMs;
+            frame.stats.updateMs = phaseClock.getElapsedTime().asSeconds() * 1000.0f;
+            frame.stats.entitiesTicked = entitiesTicked;
+            frame.stats.collisionQueries = static_cast<size_t>(queries - lastCollisionQueries);
+            frame.stats.allocations = allocations - lastAllocationCount;
+            frame.stats.input = lastInput;
+            bytesAllocated->add(allocatedBytes - lastAllocationBytes);
+            lastAllocationCount = allocations;
+            lastAllocationBytes = allocatedBytes;
+            lastCollisionQueries = queries;
+            entitiesTicked = 0;
+            lastInput = PlayerInput{};
+
+            pipeline.publish();
+        }
     }
     catch (const std::exception& e) {
         std::cerr << "error " << e.what() << std::endl;
@@ -787,17 +805,183 @@ void GameEngine::update() {
 }
 
 
+// Copies what the next drawn frame needs out of the simulation. The intro has
+// no world behind it. Menus and end screens show the frozen frame, so once the
+// render side has captured this revision of the world only the overlay and HUD
+// are recorded
+void GameEngine::recordFrame(RenderSnapshot& frame) {
+    const bool frozen = isPaused || currentState == GameState::PAUSED ||
+                        currentState == GameState::COMPLETED || currentState == GameState::GAME_OVER;
+    if (frozen && !wasFrozen) {
+        ++worldRevision;   // the world moved on since the last capture
+    }
+    wasFrozen = frozen;
+
+    frame.clear();
+    frame.state = currentState;
+    frame.paused = isPaused;
+    frame.pixelPerfect = isPixelPerfect;
+    frame.worldRevision = worldRevision;
+    frame.hud = {score, levelTime, player ? player->getRingCount() : 0, currentLives};
+    if (stateManager) {
+        stateManager->captureOverlay(frame.overlay);
+    }
 
+    if (frozen && frozenRevision.load(std::memory_order_acquire) == worldRevision) {
+        return;
+    }
+    if (currentState == GameState::PAUSED) {
+        recordPausedState(frame);
+    } else if (currentState != GameState::INTRO) {
+        recordPlayingState(frame);
+    }
+}
 
 
-// Updates the main game state including player, enemies, and collectibles
+// Moves drawing onto its own thread, or back onto the caller's
+void GameEngine::setPipelined(bool enabled) {
+    if (!window) return;
 
-void GameEngine::updateGameState() {
-    static sf::Clock clock;
-    const float deltaTime = clock.restart().asSeconds();
+    if (enabled) {
+        pipeline.start(*window, [this](const RenderSnapshot& frame) { drawFrame(frame); });
+    } else {
+        pipeline.stop();
+    }
+}
 
-    player->update();
+
+// The render thread has to let go of the window before it closes
+void GameEngine::close() {
+    pipeline.stop();
+    if (window) {
+        window->close();
+    }
+}
+
+
+
+
+
+// One step of play on the given buttons. The window steps once per frame on the
+// keyboard and wall-clock time; headless engines are stepped by their owner
+void GameEngine::step(const PlayerInput& input, float deltaTime) {
+    if (currentState != GameState::PLAYING || isPaused || !player) {
+        return;
+    }
+    player->setInput(input);
+    lastInput = input;
+    updateGameState(deltaTime);
+    const size_t active = 1 + fishEnemies.size() + crabmeatEnemies.size() + motobugEnemies.size() +
+                          buzzerEnemies.size() + scatteredRings.size() + particles.size();
+    entitiesTicked += active;
+    entitiesActive->set(static_cast<int64_t>(active));
+
+    if (recording) {
+        recording->frames.push_back(Replay::Frame{input, deltaTime, resetPending, isGodMode});
+        recording->hashes.push_back(hashState());
+        resetPending = false;
+    }
+}
+
+
+// Keeps every step from here on, with the state hash after it, under a fresh
+// seed. Start it before the first step, so playback can begin on a new engine
+void GameEngine::startRecording() {
+    recording = std::make_unique<Replay>();
+    recording->seed = static_cast<uint64_t>(std::time(nullptr));
+    random.reseed(recording->seed);
+    resetPending = false;
+}
+
+
+// Plays a recording on this engine, which has to be freshly built, and checks
+// every step against the recorded hash while there are any. Returns the first
+// step and part that came out differently, or nothing if the run matched
+std::optional<Replay::Divergence> GameEngine::playReplay(const Replay& replay) {
+    random.reseed(replay.seed);
+
+    for (size_t i = 0; i < replay.frames.size(); ++i) {
+        stepReplay(replay.frames[i]);
+
+        if (i >= replay.hashes.size()) continue;
+        const StateHash hash = hashState();
+        for (size_t part = 0; part < hash.parts.size(); ++part) {
+            if (hash.parts[part] != replay.hashes[i].parts[part]) {
+                return Replay::Divergence{i, static_cast<HashPart>(part)};
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+
+// One recorded step, with the restart or god mode change that came before it
+void GameEngine::stepReplay(const Replay::Frame& frame) {
+    if (frame.reset) resetGame();
+    if (frame.godMode != isGodMode) setGodMode(frame.godMode);
+    step(frame.input, frame.deltaTime);
+}
+
+
+// Everything a step can change, hashed part by part. Render-only state (views,
+// animation frames, particles) is left out
+StateHash GameEngine::hashState() const {
+    StateHash hash;
+
+    StateHasher playerHash;
+    if (player) player->hashState(playerHash);
+    hash[HashPart::PLAYER] = playerHash.value();
+
+    StateHasher badnikHash;
+    auto addBadniks = [&badnikHash](const auto& badniks) {
+        badnikHash.add(static_cast<int>(badniks.size()));
+        for (const auto* badnik : badniks) {
+            if (!badnik) continue;
+            badnikHash.add(badnik->getPosition());
+            badnikHash.add(badnik->isAlive());
+        }
+    };
+    addBadniks(fishEnemies);
+    addBadniks(crabmeatEnemies);
+    addBadniks(motobugEnemies);
+    addBadniks(buzzerEnemies);
+    hash[HashPart::BADNIKS] = badnikHash.value();
+
+    StateHasher ringHash;
+    ringHash.add(player ? player->getRingCount() : 0);
+    const auto& collected = ringField.getCollectedBits();
+    ringHash.add(collected.data(), collected.size() * sizeof(uint64_t));
+    for (const auto& ring : scatteredRings) {
+        if (ring.getSprite()) ringHash.add(ring.getSprite()->getPosition());
+        ringHash.add(ring.getVelocity());
+        ringHash.add(ring.getLifetime());
+        ringHash.add(ring.isActive());
+    }
+    hash[HashPart::RINGS] = ringHash.value();
+
+    StateHasher randomHash;
+    randomHash.add(random.getState());
+    hash[HashPart::RANDOM] = randomHash.value();
+
+    StateHasher timerHash;
+    timerHash.add(levelTime);
+    timerHash.add(score);
+    timerHash.add(currentLives);
+    timerHash.add(static_cast<int>(currentState));
+    if (player) player->hashTimers(timerHash);
+    hash[HashPart::TIMERS] = timerHash.value();
+
+    return hash;
+}
+
+
+// Updates the main game state including player, enemies, and collectibles
+
+void GameEngine::updateGameState(float deltaTime) {
+    player->update(deltaTime);
     updateScatteredRings(deltaTime);
+    levelTime += deltaTime;
+    updatePowerUpAuras(deltaTime);
 
     if (player && player->getPosition().x >= LEVEL_END_X) {
         SetCurrentState(GameState::COMPLETED);
@@ -825,45 +1009,29 @@ void GameEngine::updateGameState() {
     bgr_view.move(sf::Vector2f{viewMovement.x * PARALLAX_FACTOR, 0.f});
     if (!isGodMode) constrainBackgroundView();
 
-    for (auto* flower : flowerSprites) {
-        if (flower) flower->update(deltaTime);
-    }
-
-    for (auto* fish : fishEnemies) {
-        if (fish) fish->update(deltaTime);
-    }
-
-    for (auto* crabmeat : crabmeatEnemies) {
-        if (crabmeat) crabmeat->update(deltaTime);
-    }
-
-    for (auto* motobug : motobugEnemies) {
-        if (motobug) motobug->update(deltaTime);
-    }
-
-    for (auto* buzzer : buzzerEnemies) {
-        if (buzzer) buzzer->update(deltaTime);
-    }
-
-    for (auto* powerUp : powerUpSprites) {
-        if (powerUp) powerUp->update(deltaTime);
-    }
+    stepBadniks(deltaTime);
 
     sf::FloatRect playerBounds = player->getCollisionBounds();
 
+    // Contacts are tested in parallel against the player's bounds as they stand
+    // now; the loops below apply them one badnik at a time, in list order
+    gatherContacts(jobs, fishEnemies, contacts, [&](const FishEnemy& fish) {
+        return BadnikContact{playerBounds.findIntersection(fish.getCollisionBounds()).has_value(), false, false};
+    });
+    size_t index = 0;
     auto fishIt = fishEnemies.begin();
     while (fishIt != fishEnemies.end()) {
         FishEnemy* fish = *fishIt;
+        const BadnikContact contact = contacts[index++];
         if (!fish) {
             fishIt = fishEnemies.erase(fishIt);
             continue;
         }
 
-        fish->update(deltaTime);
-
-        if (fish->isAlive() && playerBounds.findIntersection(fish->getCollisionBounds())) {
+        if (fish->isAlive() && contact.touching) {
             if (player->isInBallState()) {
-                fish->die();
+                fish->die(context);
+                onBadnikDestroyed(fish->getCollisionBounds());
                 if (!fish->getFreedAnimal()) {
                     delete fish;
                     fishIt = fishEnemies.erase(fishIt);
@@ -878,19 +1046,25 @@ void GameEngine::updateGameState() {
         ++fishIt;
     }
 
+    gatherContacts(jobs, crabmeatEnemies, contacts, [&](const CrabmeatEnemy& crabmeat) {
+        return BadnikContact{playerBounds.findIntersection(crabmeat.getCollisionBounds()).has_value(),
+                             crabmeat.checkPlayerInRange(playerBounds),
+                             crabmeat.checkProjectileCollision(playerBounds)};
+    });
+    index = 0;
     auto crabmeatIt = crabmeatEnemies.begin();
     while (crabmeatIt != crabmeatEnemies.end()) {
         CrabmeatEnemy* crabmeat = *crabmeatIt;
+        const BadnikContact contact = contacts[index++];
         if (!crabmeat) {
             crabmeatIt = crabmeatEnemies.erase(crabmeatIt);
             continue;
         }
 
-        crabmeat->update(deltaTime);
-
-        if (crabmeat->isAlive() && playerBounds.findIntersection(crabmeat->getCollisionBounds())) {
+        if (crabmeat->isAlive() && contact.touching) {
             if (player->isInBallState()) {
-                crabmeat->die();
+                crabmeat->die(context);
+                onBadnikDestroyed(crabmeat->getCollisionBounds());
                 ++crabmeatIt;
                 continue;
             } else {
@@ -899,11 +1073,12 @@ void GameEngine::updateGameState() {
         }
 
         if (crabmeat->isAlive() && !player->IsDead() && !player->IsHurt()) {
-            if (crabmeat->checkPlayerInRange(player->getCollisionBounds())) {
+            bool projectileHit = contact.projectileHit;
+            if (contact.inRange) {
                 crabmeat->shoot();
+                projectileHit = crabmeat->checkProjectileCollision(player->getCollisionBounds());
             }
-            if (!player->IsInvincible() &&
-                crabmeat->checkProjectileCollision(player->getCollisionBounds())) {
+            if (!player->IsInvincible() && projectileHit) {
                 player->handleDamage();
             }
         }
@@ -916,19 +1091,23 @@ void GameEngine::updateGameState() {
         }
     }
 
+    gatherContacts(jobs, motobugEnemies, contacts, [&](const MotobugEnemy& motobug) {
+        return BadnikContact{playerBounds.findIntersection(motobug.getCollisionBounds()).has_value(), false, false};
+    });
+    index = 0;
     auto motobugIt = motobugEnemies.begin();
     while (motobugIt != motobugEnemies.end()) {
         MotobugEnemy* motobug = *motobugIt;
+        const BadnikContact contact = contacts[index++];
         if (!motobug) {
             motobugIt = motobugEnemies.erase(motobugIt);
             continue;
         }
 
-        motobug->update(deltaTime);
-
-        if (motobug->isAlive() && playerBounds.findIntersection(motobug->getCollisionBounds())) {
+        if (motobug->isAlive() && contact.touching) {
             if (player->isInBallState()) {
-                motobug->die();
+                motobug->die(context);
+                onBadnikDestroyed(motobug->getCollisionBounds());
                 if (!motobug->getFreedAnimal()) {
                     delete motobug;
                     motobugIt = motobugEnemies.erase(motobugIt);
@@ -943,24 +1122,32 @@ void GameEngine::updateGameState() {
         ++motobugIt;
     }
 
+    gatherContacts(jobs, buzzerEnemies, contacts, [&](const BuzzerEnemy& buzzer) {
+        return BadnikContact{playerBounds.findIntersection(buzzer.getCollisionBounds()).has_value(),
+                             buzzer.checkPlayerInRange(playerBounds),
+                             buzzer.checkProjectileCollision(playerBounds)};
+    });
+    index = 0;
     auto buzzerIt = buzzerEnemies.begin();
     while (buzzerIt != buzzerEnemies.end()) {
         BuzzerEnemy* buzzer = *buzzerIt;
+        const BadnikContact contact = contacts[index++];
         if (!buzzer) {
             buzzerIt = buzzerEnemies.erase(buzzerIt);
             continue;
         }
 
-        buzzer->update(deltaTime);
-
         if (buzzer->isAlive()) {
-            if (player && buzzer->checkPlayerInRange(player->getCollisionBounds())) {
+            bool projectileHit = contact.projectileHit;
+            if (contact.inRange) {
                 buzzer->shoot(player->getPosition());
+                projectileHit = buzzer->checkProjectileCollision(player->getCollisionBounds());
             }
 
-            if (playerBounds.findIntersection(buzzer->getCollisionBounds())) {
+            if (contact.touching) {
                 if (player->isInBallState()) {
-                    buzzer->die();
+                    buzzer->die(context);
+                    onBadnikDestroyed(buzzer->getCollisionBounds());
                     if (!buzzer->getFreedAnimal()) {
                         delete buzzer;
                         buzzerIt = buzzerEnemies.erase(buzzerIt);
@@ -973,8 +1160,7 @@ void GameEngine::updateGameState() {
                 }
             }
 
-            if (player && !player->IsInvincible() &&
-                buzzer->checkProjectileCollision(player->getCollisionBounds())) {
+            if (!player->IsInvincible() && projectileHit) {
                 player->handleDamage();
             }
         }
@@ -1015,31 +1201,73 @@ void GameEngine::updateGameState() {
     }
 
 
-    auto ringIt = ringSprites.begin();
-    while (ringIt != ringSprites.end()) {
-        RingSprite* ring = *ringIt;
-        if (!ring) {
-            ringIt = ringSprites.erase(ringIt);
-            continue;
+    int collectedRings = ringField.collect(playerBounds, context);
+    if (collectedRings > 0) {
+        for (int i = 0; i < collectedRings; ++i) {
+            player->addRing();
         }
+    }
 
-        if (!ring->isActive()) {
-            delete ring;
-            ringIt = ringSprites.erase(ringIt);
-            continue;
+    // Monitors break when rolled into from above, against where the player
+    // ended the step
+    const sf::FloatRect finalBounds = player->getCollisionBounds();
+    for (auto* powerUp : powerUpSprites) {
+        if (powerUp && player->isInBallState() && powerUp->checkCollision(finalBounds)) {
+            powerUp->breakBox();
         }
+    }
 
-        if (playerBounds.findIntersection(ring->getBounds())) {
-            if (!ring->isCollected()) {
-                ring->collect();
-                player->addRing();
-                updateRingDisplay();
-            }
-        }
+    updateAnimations(deltaTime);
+}
+
+
+// Invincibility stars and the shield shimmer are streamed around the player every frame
+void GameEngine::updatePowerUpAuras(float deltaTime) {
+    if (!player || player->IsDead()) return;
 
-        ring->update(deltaTime);
-        ++ringIt;
+    const sf::Vector2f center = player->getCollisionBounds().getCenter();
+    if (player->HasInvincibilityPowerUp()) {
+        particles.stream(ParticleEffect::INVINCIBILITY_STARS, center, deltaTime);
     }
+    if (player->HasShield()) {
+        particles.stream(ParticleEffect::SHIELD, center, deltaTime);
+    }
+}
+
+void GameEngine::onBadnikDestroyed(const sf::FloatRect& bounds) {
+    particles.emit(ParticleEffect::BADNIK_EXPLOSION, bounds.getCenter());
+    addScore(ENEMY_SCORE);
+}
+
+// Advances every sprite's clip in one pass, after the logic above has picked
+// which clip each one should be playing
+void GameEngine::updateAnimations(float deltaTime) {
+    map->getDecorations().update(deltaTime);
+    ringField.update(deltaTime);
+    particles.update(deltaTime);
+
+    auto advance = [deltaTime](BaseSprite& sprite) { sprite.advanceAnimation(deltaTime); };
+    forEachParallel(jobs, checkpointSprites, advance);
+    forEachParallel(jobs, fishEnemies, advance);
+    forEachParallel(jobs, crabmeatEnemies, advance);
+    forEachParallel(jobs, motobugEnemies, advance);
+    forEachParallel(jobs, buzzerEnemies, advance);
+}
+
+
+// Steps every badnik (and the animal it freed) and every power-up box on the
+// job system. Each step touches only its own sprite and reads the collision
+// map. Badniks are stepped twice a frame, as they always have been
+void GameEngine::stepBadniks(float deltaTime) {
+    auto stepTwice = [deltaTime](BaseSprite& sprite) {
+        sprite.update(deltaTime);
+        sprite.update(deltaTime);
+    };
+    forEachParallel(jobs, fishEnemies, stepTwice);
+    forEachParallel(jobs, crabmeatEnemies, stepTwice);
+    forEachParallel(jobs, motobugEnemies, stepTwice);
+    forEachParallel(jobs, buzzerEnemies, stepTwice);
+    forEachParallel(jobs, powerUpSprites, [deltaTime](BaseSprite& sprite) { sprite.update(deltaTime); });
 }
 
 
@@ -1078,21 +1306,10 @@ void GameEngine::storeInitialEnemyPositions() {
 void GameEngine::resetRings() {
     scatteredRings.clear();
 
-    for (auto* ring : ringSprites) {
-        if (ring) {
-            ring->uncollect();
-        }
-    }
-
-    ringSprites.erase(
-            std::remove_if(ringSprites.begin(), ringSprites.end(),
-                           [](RingSprite* ring) { return ring == nullptr; }),
-            ringSprites.end()
-    );
+    ringField.reset();
 
     if (player) {
         player->loseRings();
-        updateRingDisplay();
     }
 }
 
@@ -1130,53 +1347,105 @@ void GameEngine::resetEnemies() {
 
 
 void GameEngine::render() {
+    if (!window) {
+        throw std::runtime_error("Window is null");
+    }
+    if (!window->isOpen()) {
+        return;
+    }
+
+    pipeline.acquire();
+    drawFrame(pipeline.front());
+}
+
+
+// Draws one snapshot. Runs on the render thread when pipelined, so only the
+// snapshot and render-side members may be touched here. Work time counts the
+// drawing alone; the simulation runs beside it when pipelined
+void GameEngine::drawFrame(const RenderSnapshot& frame) {
     try {
         if (!window) {
             throw std::runtime_error("Window is null");
         }
 
+        lastFrameMs = frameClock.restart().asSeconds() * 1000.0f;
+        frameMs->observe(lastFrameMs);
+        drawCalls = 0;
         window->clear();
+        worldTarget.setPixelPerfect(frame.pixelPerfect);
+        if (frame.worldRevision != frozenRevision.load(std::memory_order_relaxed)) {
+            frozenFrame.invalidate();
+        }
 
-        switch (currentState) {
+        switch (frame.state) {
             case GameState::INTRO:
                 if (stateManager) {
                     window->setView(window->getDefaultView());
-                    stateManager->renderIntroScreen();
+                    stateManager->renderIntroScreen(frame.overlay);
                 }
                 break;
 
             case GameState::PLAYING:
-                renderPlayingState();
-                window->setView(window->getDefaultView());
-                if (ringCountText) {
-                    window->draw(*ringCountText);
+                if (frame.paused) {
+                    renderFrozenWorld(frame);
+                } else {
+                    frozenFrame.invalidate();
+                    renderWorld(*window, frame);
                 }
-                if (livesCountText) {
-                    window->draw(*livesCountText);
+                window->setView(window->getDefaultView());
+                if (frame.paused && stateManager) {
+                    stateManager->renderPauseMenu(frame.overlay);
                 }
+                hud.setScore(frame.hud.score);
+                hud.setTime(frame.hud.time);
+                hud.setRings(frame.hud.rings);
+                hud.setLives(frame.hud.lives);
+                drawCalls += hud.render(*window);
                 break;
 
             case GameState::PAUSED:
-                renderPausedState();
+                renderFrozenWorld(frame);
+                window->setView(window->getDefaultView());
+                if (stateManager) {
+                    stateManager->renderPauseMenu(frame.overlay);
+                }
                 break;
 
             case GameState::COMPLETED:
-                renderPlayingState();
+                renderFrozenWorld(frame);
                 window->setView(window->getDefaultView());
                 if (stateManager) {
-                    stateManager->renderCompletionScreen();
+                    stateManager->renderCompletionScreen(frame.overlay);
                 }
                 break;
 
             case GameState::GAME_OVER:
-                renderPlayingState();
+                renderFrozenWorld(frame);
                 window->setView(window->getDefaultView());
                 if (stateManager) {
-                    stateManager->renderGameOverScreen();
+                    stateManager->renderGameOverScreen(frame.overlay);
                 }
                 break;
         }
 
+        // The graph shows last frame's render time; this one is not finished yet
+        FrameStats stats = frame.stats;
+        stats.renderMs = lastRenderMs;
+        stats.drawCalls = drawCalls;
+        frameGraph.push(stats);
+        if (frame.overlay.frameGraphVisible) {
+            window->setView(window->getDefaultView());
+            frameGraph.render(*window);
+        }
+
+        float workMs = frameClock.getElapsedTime().asSeconds() * 1000.0f;
+        lastRenderMs = workMs;
+        if (flightRecorder) {
+            stats.renderMs = workMs;
+            flightRecorder->record(frame.state, stats, lastFrameMs);
+        }
+        worldTarget.setRenderScale(dynamicResolution.update(lastFrameMs, workMs));
+
         window->display();
     }
     catch (const std::exception& e) {
@@ -1186,185 +1455,145 @@ void GameEngine::render() {
 }
 
 
-void GameEngine::renderPlayingState() {
-    if (!window || !bgr || !map || !collision || !player) {
-        throw std::runtime_error("null");
-    }
-
-    window->setView(bgr_view);
-    bgr->render(*window, BG_SCALE);
-
-    window->setView(view);
-    map->render(*window, 1.0f);
-
-
+// Replays the snapshot's world through the world target (native / scaled / direct) onto screen
+void GameEngine::renderWorld(sf::RenderTarget& screen, const RenderSnapshot& frame) {
+    sf::RenderTarget& target = worldTarget.begin(screen);
+    frame.replay(target);
+    worldTarget.present(screen);
+    drawCalls += frame.getBatchCount();
+}
 
 
-    if (isGridMapVisible) {
+// Menus and end screens show a still image of the world, so it is rendered once
+// into the frozen frame and only that texture is drawn while the overlay is up
+void GameEngine::renderFrozenWorld(const RenderSnapshot& frame) {
+    if (!frozenFrame.isValid()) {
+        if (sf::RenderTarget* capture = frozenFrame.beginCapture(window->getSize())) {
+            renderWorld(*capture, frame);
+            frozenFrame.endCapture();
+            frozenRevision.store(frame.worldRevision, std::memory_order_release);
+        } else {
+            renderWorld(*window, frame);
+            return;
+        }
+    }
+    frozenFrame.render(*window);
+    ++drawCalls;
+}
 
-        collision->renderCollisionDebug(*window, 1.0f);
 
+// Records the world as it stands this step
+void GameEngine::recordPlayingState(RenderSnapshot& target) {
+    if (!bgr || !map || !collision || !player) {
+        throw std::runtime_error("null");
     }
 
+    // Both passes are quads of six vertices, so the snapshot's growth counts them
+    size_t firstVertex = target.getVertexCount();
+    target.setView(bgr_view);
+    bgr->render(target, BG_SCALE);
 
+    target.setView(view);
+    map->render(target, 1.0f);
+    tilesDrawn->add((target.getVertexCount() - firstVertex) / 6);
 
-    for (auto* flower : flowerSprites) {
 
-        if (flower) {
 
-            flower->render(*window);
 
-        }
+    if (isGridMapVisible) {
 
-    }
+        collision->renderCollisionDebug(target, 1.0f);
 
-    for (auto* bridge : bridgeSprites) {
-        if (bridge) {
-            bridge->render(*window);
-        }
     }
+    firstVertex = target.getVertexCount();
+
+
 
     for (auto* spring : springSprites) {
         if (spring) {
-            spring->render(*window);
+            spring->render(target);
         }
     }
 
     for (auto* motobug : motobugEnemies) {
         if (motobug) {
-            motobug->render(*window);
+            motobug->render(target);
         }
     }
 
     for (auto* crabmeat : crabmeatEnemies) {
         if (crabmeat) {
-            crabmeat->render(*window);
-        }
-    }
-
-    for (auto* fish : fishEnemies) {
-        if (fish) {
-            fish->setCollisionMap(collision);
+            crabmeat->render(target);
         }
     }
 
     for (auto* fish : fishEnemies) {
         if (fish) {
-            fish->render(*window);
+            fish->render(target);
         }
     }
 
     for (auto* buzzer : buzzerEnemies) {
         if (buzzer) {
-            buzzer->render(*window);
-        }
-    }
-
-    for (auto* buzzer : buzzerEnemies) {
-        if (buzzer) {
-            buzzer->setCollisionMap(collision);
+            buzzer->render(target);
         }
     }
 
     for (auto* powerUp : powerUpSprites) {
-        if (powerUp && player) {
-            sf::FloatRect bounds = player->getCollisionBounds();
-
-            if (powerUp->checkCollision(bounds)) {
-                if (player->isInBallState()) {
-                    powerUp->breakBox();
-                } else {
-                }
-            }
-
-            powerUp->render(*window);
+        if (powerUp) {
+            powerUp->render(target);
         }
     }
 
 
-    for (auto* spike : spikeSprites) {
-        if (spike) {
-            spike->render(*window);
-        }
-    }
     for (auto* checkpoint : checkpointSprites) {
         if (checkpoint) {
-            checkpoint->render(*window);
+            checkpoint->render(target);
         }
     }
 
     for (const auto& ring : scatteredRings) {
         if (ring.active && ring.sprite) {
-            ring.sprite->render(*window);
+            ring.sprite->render(target);
         }
     }
 
-    for (auto* ring : ringSprites) {
-        if (ring) {
-            ring->render(*window);
-        }
-    }
+    ringField.render(target);
 
     for (auto* platform : platformSprites) {
         if (platform) {
-            platform->render(*window);
+            platform->render(target);
         }
     }
 
-    renderScatteredRings();
-    player->render(*window);
-
-
-
-    if (isPaused) {
-
-        window->setView(window->getDefaultView());
-
-        if (stateManager) {
-
-            stateManager->renderPauseMenu();
-
-        }
-
-    }
-
+    player->render(target);
+    particles.render(target);
+    spritesDrawn->add((target.getVertexCount() - firstVertex) / 6);
 }
 
 
 
 
 
-void GameEngine::renderPausedState() {
-
+void GameEngine::recordPausedState(RenderSnapshot& target) {
 
 
-    window->setView(bgr_view);
 
-    if (bgr) bgr->render(*window, BG_SCALE);
+    target.setView(bgr_view);
 
+    if (bgr) bgr->render(target, BG_SCALE);
 
 
-    window->setView(view);
 
-    if (map) map->render(*window, 1.0f);
+    target.setView(view);
 
-    if (collision) collision->renderCollisionDebug(*window, 1.0f);
+    if (map) map->render(target, 1.0f);
 
+    if (collision) collision->renderCollisionDebug(target, 1.0f);
 
 
-    for (auto* flower : flowerSprites) {
-        if (flower) flower->render(*window);
-    }
-
-
-    if (player) player->render(*window);
-
-
-    window->setView(window->getDefaultView());
 
-    if (stateManager) {
-        stateManager->renderPauseMenu();
-    }
+    if (player) player->render(target);
 
 }
 
@@ -1387,19 +1616,21 @@ sf::Vector2f GameEngine::getSpawnPosition() const {
 
 void GameEngine::increasePlayerLives(int amount) {
     currentLives += amount;
-    updateLivesDisplay();
 }
 
 
 
 
 void GameEngine::resetGame() {
-    currentState = GameState::INTRO;
+    currentState = headless ? GameState::PLAYING : GameState::INTRO;
+    resetPending = true;
     isPaused = false;
     pauseTime = 0;
 
     currentLives = INITIAL_LIVES;
-    updateLivesDisplay();
+    score = 0;
+    levelTime = 0.0f;
+    particles.clear();
 
     lastCheckpoint.reset();
     for (auto* checkpoint : checkpointSprites) {
@@ -1407,7 +1638,15 @@ void GameEngine::resetGame() {
             checkpoint->reset();
         }
     }
-    resetEnemies();
+
+    // Badniks and item boxes come back from the shared spawn layout; nothing
+    // here reads from disk
+    clearBadniks();
+    clearPowerUps();
+    if (level) {
+        spawnBadniks();
+        spawnPowerUps();
+    }
     resetRings();
 
 
@@ -1431,7 +1670,7 @@ void GameEngine::resetGame() {
             BG_SCALE * view.getSize().y / 2.0f
     ));
 
-    if (!isMusicMuted) {
+    if (!headless && !isMusicMuted) {
         bgMusic.stop();
         bgMusic.play();
     }
@@ -1442,4 +1681,4 @@ void GameEngine::resetGame() {
 
 // Checks if the game window is still running
 
-bool GameEngine::running() const { return window->isOpen(); }
+bool GameEngine::running() const { return window && window->isOpen(); }
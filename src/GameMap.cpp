@@ -1,17 +1,8 @@
 #include "../include/GameMap.h"
+#include <algorithm>
 #include <cmath>
-#include <fstream>
-#include <sstream>
-
-GameMap::GameMap(const int tileWidth, const int tileHeight,
-                 const int tileMargin, const int tileSpacing,
-                 const std::string &tex_path, const std::string &csv_path)
-        : sprite(texture), totalTilesX(0), totalTilesY(0) {
-    this->tileWidth = tileWidth;
-    this->tileHeight = tileHeight;
-    this->tileMargin = tileMargin;
-    this->tileSpacing = tileSpacing;
-    this->loadMap(tex_path, csv_path);
+
+GameMap::GameMap(const TileLayer& layer) : layer(&layer) {
 }
 
 GameMap::~GameMap() = default;
@@ -20,24 +11,26 @@ GameMap::~GameMap() = default;
 
 sf::Vector2i GameMap::worldToTile(const sf::Vector2f& worldPos) const {
     return sf::Vector2i(
-            static_cast<int>(worldPos.x / (tileWidth * 1.0f)),
-            static_cast<int>(worldPos.y / (tileHeight * 1.0f))
+            static_cast<int>(worldPos.x / (layer->tileWidth * 1.0f)),
+            static_cast<int>(worldPos.y / (layer->tileHeight * 1.0f))
     );
 }
 
-// Loads the map texture and CSV data, creating tile rectangles and map layout
-
-void GameMap::loadMap(const std::string &texture_path, const std::string &csv_path) {
-    if (!texture.loadFromFile(texture_path)) {
-        return;
+// Cuts the tileset into tile rectangles and takes the already parsed map layout.
+// A layer without a tileset has no tiles at all
+
+TileLayer TileLayer::cut(int tileWidth, int tileHeight, int tileMargin, int tileSpacing,
+                         const sf::Texture* tileset, std::vector<std::vector<int>> data) {
+    TileLayer layer;
+    layer.tileset = tileset;
+    layer.tileWidth = tileWidth;
+    layer.tileHeight = tileHeight;
+    if (!tileset) {
+        return layer;
     }
 
-    totalTilesX = texture.getSize().x / (tileWidth + tileSpacing);
-    totalTilesY = texture.getSize().y / (tileHeight + tileSpacing);
-
-    sprite.setTexture(texture);
-    tileRects.clear();
-
+    const int totalTilesX = static_cast<int>(tileset->getSize().x) / (tileWidth + tileSpacing);
+    const int totalTilesY = static_cast<int>(tileset->getSize().y) / (tileHeight + tileSpacing);
 
     for (int tileY = 0; tileY < totalTilesY; ++tileY) {
         for (int tileX = 0; tileX < totalTilesX; ++tileX) {
@@ -46,36 +39,12 @@ void GameMap::loadMap(const std::string &texture_path, const std::string &csv_pa
                      tileMargin + tileY * (tileHeight + tileSpacing)},
                     {tileWidth, tileHeight}
             );
-            tileRects.push_back(rect);
+            layer.tileRects.push_back(rect);
         }
     }
 
-
-    std::ifstream file(csv_path);
-    if (!file.is_open()) {
-        return;
-    }
-
-    mapData.clear();
-    std::string line;
-    while (std::getline(file, line)) {
-        std::vector<int> row;
-        std::istringstream stream(line);
-        std::string cell;
-
-        while (std::getline(stream, cell, ',')) {
-            try {
-                row.push_back(std::stoi(cell));
-            } catch (...) {
-                row.push_back(0);
-            }
-        }
-
-        if (!row.empty()) {
-            mapData.push_back(row);
-        }
-    }
-    file.close();
+    layer.tiles = std::move(data);
+    return layer;
 }
 
 void GameMap::update() {}
@@ -84,6 +53,7 @@ void GameMap::update() {}
 // Performs collision detection between an object's bounds and the map tiles
 // Also handles special collision cases like platform tops (type 1 tiles)
 bool GameMap::checkCollision(const sf::FloatRect& bounds, float verticalVelocity) const {
+    if (queryCounter) queryCounter->add();
 
     sf::Vector2i topLeft = worldToTile({bounds.position.x, bounds.position.y});
     sf::Vector2i bottomRight = worldToTile({bounds.position.x + bounds.size.x,
@@ -105,10 +75,10 @@ bool GameMap::checkCollision(const sf::FloatRect& bounds, float verticalVelocity
             if (getTileType({x, y}) == 0) {
 
                 sf::FloatRect tileRect(
-                        sf::Vector2f(x * static_cast<float>(tileWidth),
-                                     y * static_cast<float>(tileHeight)),
-                        sf::Vector2f(static_cast<float>(tileWidth),
-                                     static_cast<float>(tileHeight))
+                        sf::Vector2f(x * static_cast<float>(layer->tileWidth),
+                                     y * static_cast<float>(layer->tileHeight)),
+                        sf::Vector2f(static_cast<float>(layer->tileWidth),
+                                     static_cast<float>(layer->tileHeight))
                 );
 
                 if (bounds.findIntersection(tileRect)) {
@@ -116,7 +86,7 @@ bool GameMap::checkCollision(const sf::FloatRect& bounds, float verticalVelocity
                 }
             }
             else if (getTileType({x, y}) == 1) {
-                float tileTopY = y * static_cast<float>(tileHeight);
+                float tileTopY = y * static_cast<float>(layer->tileHeight);
                 float objectBottomY = bounds.position.y + bounds.size.y;
                 float objectTopY = bounds.position.y;
 
@@ -136,55 +106,144 @@ bool GameMap::checkCollision(const sf::FloatRect& bounds, float verticalVelocity
     return false;
 }
 
-// Renders the map tiles to the window with specified scale
-
-void GameMap::render(sf::RenderWindow &window, float scale) {
-    for (size_t row = 0; row < mapData.size(); ++row) {
-        for (size_t col = 0; col < mapData[row].size(); ++col) {
-            const int tileIndex = mapData[row][col];
-            if (tileIndex < 0) continue;
-
-            sprite.setTextureRect(tileRects[tileIndex]);
-            sprite.setPosition({
-                                       col * tileWidth * scale,
-                                       row * tileHeight * scale
-                               });
-            sprite.setScale({scale, scale});
-            window.draw(sprite);
+// Bakes every tile into the vertex array of the chunk it falls in
+
+void GameMap::buildChunks(float scale) {
+    chunkColumns = (static_cast<int>(getMapWidth()) + CHUNK_TILES - 1) / CHUNK_TILES;
+    chunkRows = (static_cast<int>(getMapHeight()) + CHUNK_TILES - 1) / CHUNK_TILES;
+    chunks.assign(static_cast<size_t>(chunkColumns * chunkRows), sf::VertexArray(sf::PrimitiveType::Triangles));
+    chunkScale = scale;
+
+    const sf::Vector2f size(layer->tileWidth * scale, layer->tileHeight * scale);
+    for (size_t row = 0; row < layer->tiles.size(); ++row) {
+        for (size_t col = 0; col < layer->tiles[row].size(); ++col) {
+            const int tileIndex = layer->tiles[row][col];
+            if (tileIndex < 0 || tileIndex >= static_cast<int>(layer->tileRects.size())) continue;
+
+            auto& chunk = chunks[(row / CHUNK_TILES) * chunkColumns + col / CHUNK_TILES];
+            const sf::Vector2f pos(col * size.x, row * size.y);
+            const sf::Vector2f tex(layer->tileRects[tileIndex].position);
+            const sf::Vector2f texSize(layer->tileRects[tileIndex].size);
+
+            chunk.append(sf::Vertex{pos, sf::Color::White, tex});
+            chunk.append(sf::Vertex{pos + sf::Vector2f(size.x, 0.f), sf::Color::White, tex + sf::Vector2f(texSize.x, 0.f)});
+            chunk.append(sf::Vertex{pos + sf::Vector2f(0.f, size.y), sf::Color::White, tex + sf::Vector2f(0.f, texSize.y)});
+            chunk.append(sf::Vertex{pos + sf::Vector2f(0.f, size.y), sf::Color::White, tex + sf::Vector2f(0.f, texSize.y)});
+            chunk.append(sf::Vertex{pos + sf::Vector2f(size.x, 0.f), sf::Color::White, tex + sf::Vector2f(texSize.x, 0.f)});
+            chunk.append(sf::Vertex{pos + size, sf::Color::White, tex + texSize});
         }
     }
 }
 
+// Renders the chunks inside the current view, then the decorations on top of them
+
+void GameMap::render(RenderSnapshot& target, float scale) {
+    if (chunks.empty() || scale != chunkScale) {
+        buildChunks(scale);
+    }
 
-// Shows solid tiles in red and platform tiles in green
-void GameMap::renderCollisionDebug(sf::RenderWindow& window, float scale) const {
-    static sf::RectangleShape collisionBox({tileWidth * scale, tileHeight * scale});
-    collisionBox.setOutlineThickness(1.0f);
-    sf::View view = window.getView();
-    sf::Vector2f viewTopLeft = view.getCenter() - (view.getSize() / 2.f);
+    const sf::View& view = target.getView();
+    const sf::Vector2f topLeft = view.getCenter() - view.getSize() / 2.0f;
+    const float chunkWidth = CHUNK_TILES * layer->tileWidth * scale;
+    const float chunkHeight = CHUNK_TILES * layer->tileHeight * scale;
 
-    int startX = std::max(0, static_cast<int>(viewTopLeft.x / (tileWidth * scale)));
-    int startY = std::max(0, static_cast<int>(viewTopLeft.y / (tileHeight * scale)));
-    int endX = std::min(static_cast<int>(getMapWidth()),
-                        static_cast<int>((viewTopLeft.x + view.getSize().x) / (tileWidth * scale)) + 1);
-    int endY = std::min(static_cast<int>(getMapHeight()),
-                        static_cast<int>((viewTopLeft.y + view.getSize().y) / (tileHeight * scale)) + 1);
+    int startX = std::max(0, static_cast<int>(topLeft.x / chunkWidth));
+    int startY = std::max(0, static_cast<int>(topLeft.y / chunkHeight));
+    int endX = std::min(chunkColumns, static_cast<int>((topLeft.x + view.getSize().x) / chunkWidth) + 1);
+    int endY = std::min(chunkRows, static_cast<int>((topLeft.y + view.getSize().y) / chunkHeight) + 1);
+
+    sf::RenderStates states;
+    states.texture = layer->tileset;
     for (int y = startY; y < endY; ++y) {
         for (int x = startX; x < endX; ++x) {
-            switch(mapData[y][x]) {
+            target.draw(chunks[y * chunkColumns + x], states);
+        }
+    }
+
+    decorations.render(target);
+}
+
+
+// Bakes one block of the collision overlay: solid tiles in red, platform tiles in green.
+// Rows of the CSV may be shorter than the first, so each is bounded by its own length
+
+void GameMap::buildDebugChunk(DebugChunk& chunk, int chunkX, int chunkY, float scale) const {
+    const sf::Vector2f size(layer->tileWidth * scale, layer->tileHeight * scale);
+    const int chunkEndX = std::min(static_cast<int>(getMapWidth()), (chunkX + 1) * DEBUG_CHUNK_TILES);
+    const int endY = std::min(static_cast<int>(getMapHeight()), (chunkY + 1) * DEBUG_CHUNK_TILES);
+    auto fill = std::make_shared<sf::VertexArray>(sf::PrimitiveType::Triangles);
+    auto outline = std::make_shared<sf::VertexArray>(sf::PrimitiveType::Lines);
+
+    for (int y = chunkY * DEBUG_CHUNK_TILES; y < endY; ++y) {
+        const int endX = std::min(chunkEndX, static_cast<int>(layer->tiles[y].size()));
+        for (int x = chunkX * DEBUG_CHUNK_TILES; x < endX; ++x) {
+            sf::Color fillColor;
+            sf::Color outlineColor;
+            switch(layer->tiles[y][x]) {
                 case 0:
-                    collisionBox.setFillColor(sf::Color(255, 0, 0, 64));
-                    collisionBox.setOutlineColor(sf::Color::Red);
+                    fillColor = sf::Color(255, 0, 0, 64);
+                    outlineColor = sf::Color::Red;
                     break;
                 case 1:
-                    collisionBox.setFillColor(sf::Color(0, 255, 0, 64));
-                    collisionBox.setOutlineColor(sf::Color::Green);
+                    fillColor = sf::Color(0, 255, 0, 64);
+                    outlineColor = sf::Color::Green;
                     break;
                 default:
                     continue;
             }
-            collisionBox.setPosition(sf::Vector2f(x * tileWidth * scale, y * tileHeight * scale));
-            window.draw(collisionBox);
+
+            const sf::Vector2f topLeft(x * size.x, y * size.y);
+            const sf::Vector2f topRight = topLeft + sf::Vector2f(size.x, 0.f);
+            const sf::Vector2f bottomLeft = topLeft + sf::Vector2f(0.f, size.y);
+            const sf::Vector2f bottomRight = topLeft + size;
+
+            for (const auto& corner : {topLeft, topRight, bottomLeft, bottomLeft, topRight, bottomRight}) {
+                fill->append(sf::Vertex{corner, fillColor});
+            }
+            for (const auto& corner : {topLeft, topRight, topRight, bottomRight,
+                                       bottomRight, bottomLeft, bottomLeft, topLeft}) {
+                outline->append(sf::Vertex{corner, outlineColor});
+            }
+        }
+    }
+    chunk.fill = std::move(fill);
+    chunk.outline = std::move(outline);
+    chunk.built = true;
+}
+
+// Draws the overlay blocks in view, one or two draw calls per block
+
+void GameMap::renderCollisionDebug(RenderSnapshot& target, float scale, bool outlines) {
+    if (debugChunks.empty() || scale != debugScale) {
+        debugColumns = (static_cast<int>(getMapWidth()) + DEBUG_CHUNK_TILES - 1) / DEBUG_CHUNK_TILES;
+        int debugRows = (static_cast<int>(getMapHeight()) + DEBUG_CHUNK_TILES - 1) / DEBUG_CHUNK_TILES;
+        debugChunks.clear();
+        debugChunks.resize(static_cast<size_t>(debugColumns * debugRows));
+        debugScale = scale;
+    }
+    if (debugChunks.empty()) return;
+
+    const sf::View& view = target.getView();
+    const sf::Vector2f viewTopLeft = view.getCenter() - (view.getSize() / 2.f);
+    const float chunkWidth = DEBUG_CHUNK_TILES * layer->tileWidth * scale;
+    const float chunkHeight = DEBUG_CHUNK_TILES * layer->tileHeight * scale;
+    const int debugRows = static_cast<int>(debugChunks.size()) / debugColumns;
+
+    int startX = std::max(0, static_cast<int>(viewTopLeft.x / chunkWidth));
+    int startY = std::max(0, static_cast<int>(viewTopLeft.y / chunkHeight));
+    int endX = std::min(debugColumns, static_cast<int>((viewTopLeft.x + view.getSize().x) / chunkWidth) + 1);
+    int endY = std::min(debugRows, static_cast<int>((viewTopLeft.y + view.getSize().y) / chunkHeight) + 1);
+
+    for (int y = startY; y < endY; ++y) {
+        for (int x = startX; x < endX; ++x) {
+            DebugChunk& chunk = debugChunks[y * debugColumns + x];
+            if (!chunk.built) {
+                buildDebugChunk(chunk, x, y, scale);
+            }
+            target.draw(chunk.fill);
+            if (outlines) {
+                target.draw(chunk.outline);
+            }
         }
     }
-}
\ No newline at end of file
+}
@@ -1,18 +1,22 @@
 #include "../include/GameStateManager.h"
 #include "../include/GameEngine.h"
 #include "SoundManager.h"
+#include "AssetPack.h"
 #include <stdexcept>
 #include <iostream>
 #include <algorithm>
 #include <filesystem>
 
-GameStateManager::GameStateManager(sf::RenderWindow* window, sf::Music& music, float& volume, bool& muted, bool& godMode, bool& gridVisible)
+GameStateManager::GameStateManager(sf::RenderWindow* window, sf::Music& music, SoundManager& effects, float& volume, bool& muted, bool& godMode, bool& gridVisible, bool& frameGraph, bool& pixelPerfect)
         : window(window)
         , bgMusic(music)
+        , soundEffects(effects)
         , musicVolume(volume)
         , isMusicMuted(muted)
         , isGodMode(godMode)
         , isGridMapVisible(gridVisible)
+        , isFrameGraphVisible(frameGraph)
+        , isPixelPerfect(pixelPerfect)
 {
     try {
         initIntroScreen();
@@ -22,7 +26,7 @@ GameStateManager::GameStateManager(sf::RenderWindow* window, sf::Music& music, f
         bgMusic.stop();
 
 
-        SoundManager::getInstance().setVolume(musicVolume);
+        soundEffects.setVolume(musicVolume);
     }
     catch (const std::exception& e) {
         cleanup();
@@ -45,6 +49,8 @@ void GameStateManager::cleanup() {
     delete godModeText;
     delete completionText;
     delete gridMapText;
+    delete frameGraphText;
+    delete pixelPerfectText;
     delete gameOverText;
     gameOverText = nullptr;
     introSprite = nullptr;
@@ -56,12 +62,14 @@ void GameStateManager::cleanup() {
     godModeText = nullptr;
     completionText = nullptr;
     gridMapText = nullptr;
+    frameGraphText = nullptr;
+    pixelPerfectText = nullptr;
 }
 
 
 void GameStateManager::initIntroScreen() {
 
-    if (!introTexture.loadFromFile("./assets/intro.png")) {
+    if (!AssetPack::load("./assets/intro.png", introTexture)) {
         throw std::runtime_error("fail");
     }
 
@@ -72,7 +80,7 @@ void GameStateManager::initIntroScreen() {
     introSprite->setScale(sf::Vector2f(scaleX, scaleY));
 
 
-    if (!introFont.openFromFile("./assets/arial.ttf")) {
+    if (!AssetPack::load("./assets/Arial.ttf", introFont)) {
         throw std::runtime_error("fail");
     }
 
@@ -96,10 +104,22 @@ void GameStateManager::initIntroScreen() {
     centerText(pressEnterText, 100.f);
 
 
+    const sf::Vector2f barSize(static_cast<float>(window->getSize().x) * 0.5f, 6.f);
+    const sf::Vector2f barPos((static_cast<float>(window->getSize().x) - barSize.x) / 2.f,
+                              static_cast<float>(window->getSize().y) - 40.f);
+    loadBarBg.setSize(barSize);
+    loadBarBg.setPosition(barPos);
+    loadBarBg.setFillColor(sf::Color(255, 255, 255, 60));
+    loadBar.setSize(sf::Vector2f(0.f, barSize.y));
+    loadBar.setPosition(barPos);
+    loadBar.setFillColor(sf::Color(255, 215, 0));
+
+
     fadeAlpha = 255.0f;
     fadingOut = false;
     completionFadeAlpha = 0.0f;
     completionFadingIn = true;
+    completionFadeClock.restart();
 }
 
 
@@ -115,30 +135,42 @@ void GameStateManager::initPauseMenu() {
     musicText = new sf::Text(introFont, "Music", 30);
     godModeText = new sf::Text(introFont, "God Mode", 30);
     gridMapText = new sf::Text(introFont, "Grid Map", 30);
+    frameGraphText = new sf::Text(introFont, "Frame Graph", 30);
+    pixelPerfectText = new sf::Text(introFont, "Pixel Perfect", 30);
 
     volumeSliderBg.setSize(sf::Vector2f(200.f, 10.f));
     volumeSlider.setSize(sf::Vector2f(200.f * (musicVolume / 100.f), 10.f));
     musicToggle.setSize(sf::Vector2f(30.f, 30.f));
     godModeToggle.setSize(sf::Vector2f(30.f, 30.f));
     gridMapToggle.setSize(sf::Vector2f(30.f, 30.f));
+    frameGraphToggle.setSize(sf::Vector2f(30.f, 30.f));
+    pixelPerfectToggle.setSize(sf::Vector2f(30.f, 30.f));
 
     volumeSliderBg.setFillColor(sf::Color(100, 100, 100));
     volumeSlider.setFillColor(sf::Color::White);
-    musicToggle.setFillColor(isMusicMuted ? sf::Color::Red : sf::Color::Green);
-    godModeToggle.setFillColor(isGodMode ? sf::Color::Green : sf::Color::Red);
-    gridMapToggle.setFillColor(isGridMapVisible ? sf::Color::Green : sf::Color::Red);
-
-    centerText(pauseText, -100.f);
-    centerText(volumeText, 0.f);
-    centerText(musicText, 100.f);
-    centerText(godModeText, 150.f);
-    centerText(gridMapText, 200.f);
 
-    volumeSliderBg.setPosition(sf::Vector2f(windowSize.x / 2.f - 100.f, windowSize.y / 2.f));
+    // One row every ROW_STEP pixels below the volume slider, started high enough
+    // that the last toggle still ends inside the 600px window
+    constexpr float VOLUME_ROW = -150.f;
+    constexpr float ROW_STEP = 50.f;
+    auto rowY = [](int row) { return VOLUME_ROW + ROW_STEP * static_cast<float>(row); };
+
+    centerText(pauseText, -230.f);
+    centerText(volumeText, rowY(0));
+    centerText(musicText, rowY(1));
+    centerText(godModeText, rowY(2));
+    centerText(gridMapText, rowY(3));
+    centerText(frameGraphText, rowY(4));
+    centerText(pixelPerfectText, rowY(5));
+
+    const float toggleX = windowSize.x / 2.f - 100.f;
+    volumeSliderBg.setPosition(sf::Vector2f(toggleX, windowSize.y / 2.f + rowY(0)));
     volumeSlider.setPosition(volumeSliderBg.getPosition());
-    musicToggle.setPosition(sf::Vector2f(windowSize.x / 2.f - 100.f, windowSize.y / 2.f + 100.f));
-    godModeToggle.setPosition(sf::Vector2f(windowSize.x / 2.f - 100.f, windowSize.y / 2.f + 150.f));
-    gridMapToggle.setPosition(sf::Vector2f(windowSize.x / 2.f - 100.f, windowSize.y / 2.f + 200.f));
+    musicToggle.setPosition(sf::Vector2f(toggleX, windowSize.y / 2.f + rowY(1)));
+    godModeToggle.setPosition(sf::Vector2f(toggleX, windowSize.y / 2.f + rowY(2)));
+    gridMapToggle.setPosition(sf::Vector2f(toggleX, windowSize.y / 2.f + rowY(3)));
+    frameGraphToggle.setPosition(sf::Vector2f(toggleX, windowSize.y / 2.f + rowY(4)));
+    pixelPerfectToggle.setPosition(sf::Vector2f(toggleX, windowSize.y / 2.f + rowY(5)));
 }
 
 void GameStateManager::initCompletionScreen() {
@@ -193,7 +225,20 @@ void GameStateManager::initGameOverScreen() {
     ));
 }
 
-void GameStateManager::renderGameOverScreen() const {
+// Runs on the simulation thread once per frame
+void GameStateManager::captureOverlay(OverlayState& overlay) const {
+    overlay.introAlpha = fadeAlpha;
+    overlay.loadProgress = loadProgress;
+    overlay.completionAlpha = completionFadeAlpha;
+    overlay.musicVolume = musicVolume;
+    overlay.musicMuted = isMusicMuted;
+    overlay.godMode = isGodMode;
+    overlay.gridMapVisible = isGridMapVisible;
+    overlay.frameGraphVisible = isFrameGraphVisible;
+    overlay.pixelPerfect = isPixelPerfect;
+}
+
+void GameStateManager::renderGameOverScreen(const OverlayState&) const {
     if (!window || !gameOverText) {
         return;
     }
@@ -215,8 +260,8 @@ void GameStateManager::handleGameOverInput() {
         }
     }
     else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Escape)) {
-        if (window) {
-            window->close();
+        if (engineRef) {
+            engineRef->close();
         }
     }
 }
@@ -232,11 +277,11 @@ void GameStateManager::centerText(sf::Text* text, float yOffset) {
     text->setPosition(sf::Vector2f(windowSize.x / 2.f, windowSize.y / 2.f + yOffset));
 }
 
-void GameStateManager::renderIntroScreen() const {
+void GameStateManager::renderIntroScreen(const OverlayState& overlay) const {
     if (!window || !introSprite || !introText || !pressEnterText) return;
 
     sf::Color color = sf::Color::White;
-    color.a = static_cast<uint8_t>(fadeAlpha);
+    color.a = static_cast<uint8_t>(overlay.introAlpha);
 
     introSprite->setColor(color);
     introText->setFillColor(color);
@@ -245,17 +290,23 @@ void GameStateManager::renderIntroScreen() const {
     window->draw(*introSprite);
     window->draw(*introText);
     window->draw(*pressEnterText);
+
+    if (overlay.loadProgress < 1.0f) {
+        sf::RectangleShape bar = loadBar;
+        bar.setSize(sf::Vector2f(loadBarBg.getSize().x * overlay.loadProgress, loadBarBg.getSize().y));
+        window->draw(loadBarBg);
+        window->draw(bar);
+    }
+}
+
+//function that sets how full the intro's loading bar is
+void GameStateManager::setLoadProgress(float progress) {
+    loadProgress = std::clamp(progress, 0.0f, 1.0f);
 }
 
 void GameStateManager::updateIntroScreen() {
     if (fadingOut) {
         fadeAlpha = std::max(0.f, fadeAlpha - 3.0f);
-        sf::Color color = sf::Color::White;
-        color.a = static_cast<uint8_t>(fadeAlpha);
-
-        if (introSprite) introSprite->setColor(color);
-        if (introText) introText->setFillColor(color);
-        if (pressEnterText) pressEnterText->setFillColor(color);
     }
 }
 
@@ -265,23 +316,38 @@ void GameStateManager::handleIntroInput() {
     }
 }
 
-void GameStateManager::renderPauseMenu() const {
+void GameStateManager::renderPauseMenu(const OverlayState& overlay) const {
     if (!window) return;
 
-    sf::RectangleShape overlay(sf::Vector2f(window->getSize()));
-    overlay.setFillColor(sf::Color(0, 0, 0, 128));
+    sf::RectangleShape shade(sf::Vector2f(window->getSize()));
+    shade.setFillColor(sf::Color(0, 0, 0, 128));
 
-    window->draw(overlay);
+    sf::RectangleShape slider = volumeSlider;
+    slider.setSize(sf::Vector2f(volumeSliderBg.getSize().x * (overlay.musicVolume / 100.f), 10.f));
+    if (volumeText) {
+        volumeText->setString("Volume: " + std::to_string(static_cast<int>(overlay.musicVolume)) + "%");
+    }
+
+    window->draw(shade);
     if (pauseText) window->draw(*pauseText);
     if (volumeText) window->draw(*volumeText);
     window->draw(volumeSliderBg);
-    window->draw(volumeSlider);
-    window->draw(musicToggle);
+    window->draw(slider);
+    drawToggle(musicToggle, !overlay.musicMuted);
     if (musicText) window->draw(*musicText);
-    window->draw(godModeToggle);
+    drawToggle(godModeToggle, overlay.godMode);
     if (godModeText) window->draw(*godModeText);
     if (gridMapText) window->draw(*gridMapText);
-    window->draw(gridMapToggle);
+    drawToggle(gridMapToggle, overlay.gridMapVisible);
+    if (frameGraphText) window->draw(*frameGraphText);
+    drawToggle(frameGraphToggle, overlay.frameGraphVisible);
+    if (pixelPerfectText) window->draw(*pixelPerfectText);
+    drawToggle(pixelPerfectToggle, overlay.pixelPerfect);
+}
+
+void GameStateManager::drawToggle(sf::RectangleShape toggle, bool on) const {
+    toggle.setFillColor(on ? sf::Color::Green : sf::Color::Red);
+    window->draw(toggle);
 }
 
 void GameStateManager::handlePauseMenuClick(int x, int y) {
@@ -298,22 +364,38 @@ void GameStateManager::handlePauseMenuClick(int x, int y) {
     if (gridMapToggle.getGlobalBounds().contains(mousePos)) {
         toggleGridMap();
     }
+
+    if (frameGraphToggle.getGlobalBounds().contains(mousePos)) {
+        toggleFrameGraph();
+    }
+
+    if (pixelPerfectToggle.getGlobalBounds().contains(mousePos)) {
+        togglePixelPerfect();
+    }
 }
 
 void GameStateManager::toggleGridMap() {
     isGridMapVisible = !isGridMapVisible;
-    gridMapToggle.setFillColor(isGridMapVisible ? sf::Color::Green : sf::Color::Red);
+}
+
+// Also on F3, in any state
+void GameStateManager::toggleFrameGraph() {
+    isFrameGraphVisible = !isFrameGraphVisible;
+}
+
+// Switches the world between drawing straight into the window and drawing at
+// native resolution with an integer upscale
+void GameStateManager::togglePixelPerfect() {
+    isPixelPerfect = !isPixelPerfect;
 }
 
 void GameStateManager::toggleMusic() {
     isMusicMuted = !isMusicMuted;
     isMusicMuted ? bgMusic.pause() : bgMusic.play();
-    musicToggle.setFillColor(isMusicMuted ? sf::Color::Red : sf::Color::Green);
 }
 
 void GameStateManager::toggleGodMode() {
     isGodMode = !isGodMode;
-    godModeToggle.setFillColor(isGodMode ? sf::Color::Green : sf::Color::Red);
     if (engineRef) {
         engineRef->setGodMode(isGodMode);
     }
@@ -324,39 +406,31 @@ void GameStateManager::setMusicVolume(float volume) {
 
     bgMusic.setVolume(musicVolume);
 
-    SoundManager::getInstance().setVolume(musicVolume);
-
-
-    volumeText->setString("Volume: " + std::to_string(static_cast<int>(musicVolume)) + "%");
-    volumeSlider.setSize(sf::Vector2f(volumeSliderBg.getSize().x * (musicVolume / 100.f), 10.f));
+    soundEffects.setVolume(musicVolume);
 }
 
 void GameStateManager::updateCompletionScreen() {
-    static sf::Clock fadeTimer;
-
     if (completionFadingIn) {
         float fadeSpeed = 2.0f;
-        completionFadeAlpha = std::min(255.0f, completionFadeAlpha + (fadeSpeed * fadeTimer.restart().asSeconds() * 60.0f));
-
-        sf::Color textColor = sf::Color::White;
-        textColor.a = static_cast<uint8_t>(completionFadeAlpha);
-        if (completionText) {
-            completionText->setFillColor(textColor);
-        }
+        completionFadeAlpha = std::min(255.0f, completionFadeAlpha + (fadeSpeed * completionFadeClock.restart().asSeconds() * 60.0f));
     }
 }
 
-void GameStateManager::renderCompletionScreen() const {
+void GameStateManager::renderCompletionScreen(const OverlayState& overlay) const {
     if (!window || !completionText) {
         return;
     }
 
-    sf::RectangleShape overlay(sf::Vector2f(window->getSize()));
-    sf::Color overlayColor = sf::Color::Black;
-    overlayColor.a = static_cast<uint8_t>(completionFadeAlpha * 0.75f);
-    overlay.setFillColor(overlayColor);
+    sf::RectangleShape shade(sf::Vector2f(window->getSize()));
+    sf::Color shadeColor = sf::Color::Black;
+    shadeColor.a = static_cast<uint8_t>(overlay.completionAlpha * 0.75f);
+    shade.setFillColor(shadeColor);
 
-    window->draw(overlay);
+    sf::Color textColor = sf::Color::White;
+    textColor.a = static_cast<uint8_t>(overlay.completionAlpha);
+    completionText->setFillColor(textColor);
+
+    window->draw(shade);
     window->draw(*completionText);
 }
 
@@ -368,8 +442,8 @@ void GameStateManager::handleCompletionInput() {
             }
         }
         else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Escape)) {
-            if (window) {
-                window->close();
+            if (engineRef) {
+                engineRef->close();
             }
         }
     }
@@ -0,0 +1,189 @@
+#include "../include/Hud.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    const std::string HUD_CHARACTERS = "0123456789:SCORETIMRNGLV";
+    const sf::Color OUTLINE_COLOR = sf::Color::Black;
+    const sf::Color SCORE_COLOR = sf::Color(255, 215, 0);
+    const sf::Color RING_COLOR = sf::Color(255, 215, 0);
+    const sf::Color LIVES_COLOR = sf::Color(255, 100, 100);
+    constexpr float MARGIN = 20.0f;
+    constexpr float LINE_HEIGHT = 30.0f;
+    constexpr float RIGHT_COLUMN_WIDTH = 240.0f;
+}
+
+// Rasterises every character in the set once, then copies the font page. A
+// space only moves the pen, so it gets an advance and no quad
+bool GlyphAtlas::build(const sf::Font& font, unsigned characterSize, const std::string& characters, float outlineThickness) {
+    for (char c : characters) {
+        auto& glyph = glyphs[static_cast<unsigned char>(c) % glyphs.size()];
+        const sf::Glyph& fill = font.getGlyph(c, characterSize, false);
+        glyph.fill = {fill.bounds, fill.textureRect};
+        if (outlineThickness > 0.0f) {
+            const sf::Glyph& outline = font.getGlyph(c, characterSize, false, outlineThickness);
+            glyph.outline = {outline.bounds, outline.textureRect};
+        }
+        glyph.advance = fill.advance;
+        glyph.loaded = c != ' ';
+    }
+    glyphs[' '].advance = font.getGlyph(' ', characterSize, false).advance;
+
+    texture = font.getTexture(characterSize);
+    return texture.getSize().x != 0;
+}
+
+bool Hud::init(const sf::Font& font, sf::Vector2u windowSize) {
+    if (!atlas.build(font, CHARACTER_SIZE, HUD_CHARACTERS, OUTLINE_THICKNESS)) {
+        std::cerr << "fail hud atlas" << std::endl;
+        return false;
+    }
+
+    for (char c = '0'; c <= '9'; ++c) {
+        digitAdvance = std::max(digitAdvance, atlas[c].advance);
+    }
+
+    outlineVertices.clear();
+    fillVertices.clear();
+    const float rightColumn = static_cast<float>(windowSize.x) - RIGHT_COLUMN_WIDTH;
+    addField(Counter::RINGS, {MARGIN, MARGIN}, RING_COLOR);
+    addField(Counter::LIVES, {MARGIN, MARGIN + LINE_HEIGHT}, LIVES_COLOR);
+    addField(Counter::SCORE, {rightColumn, MARGIN}, SCORE_COLOR);
+    addField(Counter::TIME, {rightColumn, MARGIN + LINE_HEIGHT}, SCORE_COLOR);
+
+    ready = true;
+    setScore(0);
+    setTime(0.0f);
+    setRings(0);
+    setLives(0);
+    return true;
+}
+
+void Hud::setScore(int score) {
+    auto& field = fields[static_cast<size_t>(Counter::SCORE)];
+    if (field.value == score) return;
+    setField(Counter::SCORE, score, std::to_string(score));
+}
+
+// Only whole seconds are shown, so the quads change at most once a second
+void Hud::setTime(float seconds) {
+    const int whole = static_cast<int>(std::max(0.0f, seconds));
+    auto& field = fields[static_cast<size_t>(Counter::TIME)];
+    if (field.value == whole) return;
+
+    const int secs = whole % 60;
+    std::string text = std::to_string(whole / 60) + (secs < 10 ? ":0" : ":") + std::to_string(secs);
+    setField(Counter::TIME, whole, text);
+}
+
+void Hud::setRings(int rings) {
+    auto& field = fields[static_cast<size_t>(Counter::RINGS)];
+    if (field.value == rings) return;
+    setField(Counter::RINGS, rings, std::to_string(rings));
+}
+
+void Hud::setLives(int lives) {
+    auto& field = fields[static_cast<size_t>(Counter::LIVES)];
+    if (field.value == lives) return;
+    setField(Counter::LIVES, lives, std::to_string(lives));
+}
+
+size_t Hud::render(sf::RenderTarget& target) const {
+    if (!ready) return 0;
+
+    sf::RenderStates states;
+    states.texture = &atlas.texture;
+    size_t draws = 0;
+    for (const sf::VertexArray* vertices : {&outlineVertices, &fillVertices}) {
+        if (vertices->getVertexCount() == 0) continue;
+        target.draw(*vertices, states);
+        ++draws;
+    }
+    return draws;
+}
+
+void Hud::addLabel(const std::string& label, sf::Vector2f position, sf::Color color) {
+    sf::Vector2f pen = position;
+    for (char c : label) {
+        const auto& glyph = atlas[c];
+        if (glyph.loaded) {
+            const size_t first = fillVertices.getVertexCount();
+            outlineVertices.resize(first + 6);
+            fillVertices.resize(first + 6);
+            writeQuad(first, glyph.outline, pen, OUTLINE_COLOR, true);
+            writeQuad(first, glyph.fill, pen, color, false);
+        }
+        pen.x += glyph.advance;
+    }
+}
+
+// A field is its label followed by MAX_DIGITS fixed-width slots, so changing
+// one character never moves its neighbours
+void Hud::addField(Counter counter, sf::Vector2f position, sf::Color color) {
+    static const char* const LABELS[] = {"SCORE: ", "TIME: ", "RINGS: ", "LIVES: "};
+    const std::string label = LABELS[static_cast<size_t>(counter)];
+    addLabel(label, position, color);
+
+    float labelWidth = 0.0f;
+    for (char c : label) {
+        labelWidth += atlas[c].advance;
+    }
+
+    auto& field = fields[static_cast<size_t>(counter)];
+    field.origin = {position.x + labelWidth, position.y};
+    field.color = color;
+    field.firstVertex = fillVertices.getVertexCount();
+    field.shown.assign(MAX_DIGITS, ' ');
+    field.value = -1;
+
+    const size_t end = field.firstVertex + MAX_DIGITS * 6;
+    outlineVertices.resize(end);
+    fillVertices.resize(end);
+}
+
+// Rewrites only the slots whose character differs from what is on screen
+void Hud::setField(Counter counter, int value, const std::string& text) {
+    auto& field = fields[static_cast<size_t>(counter)];
+    field.value = value;
+    if (!ready) return;
+
+    for (int slot = 0; slot < MAX_DIGITS; ++slot) {
+        const char c = slot < static_cast<int>(text.size()) ? text[slot] : ' ';
+        if (field.shown[slot] == c) continue;
+        field.shown[slot] = c;
+
+        const size_t first = field.firstVertex + static_cast<size_t>(slot) * 6;
+        const auto& glyph = atlas[c];
+        if (!glyph.loaded) {
+            for (size_t i = 0; i < 6; ++i) {
+                outlineVertices[first + i] = sf::Vertex{};
+                fillVertices[first + i] = sf::Vertex{};
+            }
+            continue;
+        }
+
+        const sf::Vector2f pen(field.origin.x + digitAdvance * static_cast<float>(slot), field.origin.y);
+        writeQuad(first, glyph.outline, pen, OUTLINE_COLOR, true);
+        writeQuad(first, glyph.fill, pen, field.color, false);
+    }
+}
+
+// Same placement as sf::Text: the pen sits on the baseline one character size down
+void Hud::writeQuad(size_t first, const GlyphAtlas::Quad& quad, sf::Vector2f pen, sf::Color color, bool outline) {
+    sf::VertexArray& vertices = outline ? outlineVertices : fillVertices;
+
+    const sf::Vector2f topLeft(pen.x + quad.bounds.position.x,
+                               pen.y + static_cast<float>(CHARACTER_SIZE) + quad.bounds.position.y);
+    const sf::Vector2f size = quad.bounds.size;
+    const sf::Vector2f uv(static_cast<float>(quad.textureRect.position.x),
+                          static_cast<float>(quad.textureRect.position.y));
+    const sf::Vector2f uvSize(static_cast<float>(quad.textureRect.size.x),
+                              static_cast<float>(quad.textureRect.size.y));
+
+    vertices[first + 0] = sf::Vertex{topLeft, color, uv};
+    vertices[first + 1] = sf::Vertex{{topLeft.x + size.x, topLeft.y}, color, {uv.x + uvSize.x, uv.y}};
+    vertices[first + 2] = sf::Vertex{{topLeft.x, topLeft.y + size.y}, color, {uv.x, uv.y + uvSize.y}};
+    vertices[first + 3] = vertices[first + 2];
+    vertices[first + 4] = vertices[first + 1];
+    vertices[first + 5] = sf::Vertex{topLeft + size, color, uv + uvSize};
+}
@@ -0,0 +1,121 @@
+#include "../include/JobSystem.h"
+#include <algorithm>
+
+// By default one core is left to the calling thread and one to the render thread
+JobSystem::JobSystem(unsigned workerCount) {
+    if (workerCount == AUTO_WORKERS) {
+        const unsigned cores = std::thread::hardware_concurrency();
+        workerCount = cores > 2 ? cores - 2 : 1;
+    }
+
+    for (unsigned i = 0; i <= workerCount; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (unsigned i = 1; i <= workerCount; ++i) {
+        workers.emplace_back(&JobSystem::workerLoop, this, static_cast<size_t>(i));
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Ranges up to one grain long run inline, so small levels never touch the workers
+void JobSystem::parallelFor(size_t count, size_t grain, const RangeFunction& body) {
+    if (count == 0) return;
+    grain = std::max<size_t>(1, grain);
+    if (count <= grain || workers.empty()) {
+        body(0, count);
+        return;
+    }
+
+    Batch batch;
+    batch.body = &body;
+    const size_t chunks = (count + grain - 1) / grain;
+    batch.pending = chunks;
+
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        const size_t begin = chunk * grain;
+        Queue& queue = *queues[chunk % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(Job{&batch, begin, std::min(count, begin + grain)});
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queued += chunks;
+    }
+    wake.notify_all();
+
+    Job job{};
+    while (batch.pending.load(std::memory_order_acquire) > 0) {
+        if (findJob(0, job)) {
+            run(job);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    if (batch.error) {
+        std::rethrow_exception(batch.error);
+    }
+}
+
+// Newest job from our own deque first, then the oldest from anyone else's
+bool JobSystem::findJob(size_t self, Job& job) {
+    {
+        Queue& own = *queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = own.jobs.back();
+            own.jobs.pop_back();
+            --queued;
+            return true;
+        }
+    }
+
+    for (size_t offset = 1; offset < queues.size(); ++offset) {
+        Queue& victim = *queues[(self + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = victim.jobs.front();
+            victim.jobs.pop_front();
+            --queued;
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::run(const Job& job) {
+    Batch& batch = *job.batch;
+    try {
+        (*batch.body)(job.begin, job.end);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(batch.errorMutex);
+        if (!batch.error) {
+            batch.error = std::current_exception();
+        }
+    }
+    batch.pending.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::workerLoop(size_t self) {
+    Job job{};
+    for (;;) {
+        if (findJob(self, job)) {
+            run(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return stopping || queued > 0; });
+        if (stopping) return;
+    }
+}
@@ -0,0 +1,303 @@
+#include "../include/LevelData.h"
+#include <stdexcept>
+
+namespace {
+    const char* const LEVEL_IMAGES[] = {
+            "./assets/background_foreground64.png", "./assets/Map_Tilesheet.png", "./assets/grid_tile_set.png",
+            "./assets/sonic_sheet_fixed.png", "./assets/misc_fixed.png", "./assets/enemies_sheet_fixed.png",
+            "./assets/animals_fixed.png", "./assets/flowers.png"
+    };
+    const char* const LEVEL_TABLES[] = {
+            "./assets/background.csv", "./assets/Map.csv", "./assets/basic_gridmap.csv"
+    };
+}
+
+// The images and map tables the level is built from; sounds are the engine's business
+void LevelData::queueAssets(AssetLoader& assets) {
+    for (const char* path : LEVEL_IMAGES) {
+        assets.queueImage(path);
+    }
+    for (const char* path : LEVEL_TABLES) {
+        assets.queueTable(path);
+    }
+}
+
+// Called once the loader is done. Keeps the loader alive for as long as the
+// level is, since the layers and archetypes point at its textures
+std::shared_ptr<const LevelData> LevelData::load(std::shared_ptr<const AssetLoader> assets) {
+    auto tableOf = [&assets](const char* path) {
+        const AssetLoader::Table* table = assets->table(path);
+        return table ? *table : AssetLoader::Table();
+    };
+
+    auto level = std::make_shared<LevelData>();
+    level->assets = assets;
+    level->background = TileLayer::cut(64, 64, 0, 0, assets->texture("./assets/background_foreground64.png"), tableOf("./assets/background.csv"));
+    level->foreground = TileLayer::cut(256, 256, 8, 8, assets->texture("./assets/Map_Tilesheet.png"), tableOf("./assets/Map.csv"));
+    level->collision = TileLayer::cut(2, 2, 0, 0, assets->texture("./assets/grid_tile_set.png"), tableOf("./assets/basic_gridmap.csv"));
+
+    level->playerSheet = assets->texture("./assets/sonic_sheet_fixed.png");
+    if (!level->playerSheet) {
+        throw std::runtime_error("fail ./assets/sonic_sheet_fixed.png");
+    }
+    level->archetypes.resolve(*assets);
+
+    level->placeActors();
+    level->placeScenery();
+    return level;
+}
+
+void LevelData::placeActors() {
+    playerStart = sf::Vector2f(179.2f, 919.0f);
+
+    ringGroups = {
+            {79 * 4, 216 * 4, 3},
+            {281 * 4, 198 * 4, 6},
+            {622 * 4, 174 * 4, 2},
+            {735 * 4, 176 * 4, 2},
+            {1108 * 4, 201 * 4, 3},
+            {1157 * 4, 201 * 4, 3},
+            {1617 * 4, 217 * 4, 5},
+            {2006 * 4, 282 * 4, 6}
+    };
+
+    rings = {
+            sf::Vector2f(3400, 686),
+            sf::Vector2f(3432, 673),
+            sf::Vector2f(3466, 655),
+            sf::Vector2f(3500, 639),
+            sf::Vector2f(3858, 509),
+            sf::Vector2f(3895, 513),
+            sf::Vector2f(3934, 512),
+            sf::Vector2f(4692, 566),
+            sf::Vector2f(4728, 577),
+            sf::Vector2f(4762, 593),
+            sf::Vector2f(4795, 609),
+            sf::Vector2f(4834, 617),
+            sf::Vector2f(1656 , 895),
+            sf::Vector2f(1688 , 911),
+            sf::Vector2f(1720 , 925),
+            sf::Vector2f(1755 , 936),
+            sf::Vector2f(1795 , 939),
+            sf::Vector2f(1839 , 935),
+            sf::Vector2f(1875 , 906),
+            sf::Vector2f(5852, 429),
+            sf::Vector2f(5892, 429),
+            sf::Vector2f(5932, 419),
+            sf::Vector2f(5971, 404),
+            sf::Vector2f(6012, 385),
+            sf::Vector2f(6046, 369),
+            sf::Vector2f(6104, 364),
+            sf::Vector2f(6148, 364),
+            sf::Vector2f(6196, 366),
+            sf::Vector2f(6244, 368),
+            sf::Vector2f(6292, 370),
+            sf::Vector2f(6340, 634),
+            sf::Vector2f(6388, 635),
+            sf::Vector2f(6436, 635),
+            sf::Vector2f(6484, 370),
+            sf::Vector2f(6532, 371),
+            sf::Vector2f(6580, 366),
+            sf::Vector2f(6628, 364),
+            sf::Vector2f(9018, 1133),
+            sf::Vector2f(9055, 1142),
+            sf::Vector2f(9086, 1157),
+            sf::Vector2f(9117, 1193),
+            sf::Vector2f(9150, 1190),
+            sf::Vector2f(9188, 1198),
+            sf::Vector2f(9228, 1198),
+            sf::Vector2f(9266, 1198),
+            sf::Vector2f(9305, 1198),
+            sf::Vector2f(9342, 1198)
+    };
+
+    spikes = {
+
+            sf::Vector2f(835 * 4, 216 * 4),
+            sf::Vector2f(847 * 4, 218 * 4),
+            sf::Vector2f(860 * 4, 218 * 4),
+            sf::Vector2f(881 * 4, 216 * 4),
+            sf::Vector2f(977 * 4, 233 * 4),
+            sf::Vector2f(997 * 4, 234 * 4),
+            sf::Vector2f(1110 * 4, 218 * 4),
+            sf::Vector2f(1136 * 4, 216 * 4),
+            sf::Vector2f(1160 * 4, 217 * 4),
+            sf::Vector2f(1325 * 4, 201 * 4),
+            sf::Vector2f(1338 * 4, 200 * 4),
+            sf::Vector2f(1351 * 4, 200 * 4),
+            sf::Vector2f(1923 * 4, 297 * 4),
+            sf::Vector2f(2051 * 4, 296 * 4)
+    };
+
+    checkpoints = {
+
+            sf::Vector2f(1626 * 4, 210 * 4),
+            sf::Vector2f(1140 * 4, 128 * 4)
+    };
+
+    platforms = {
+
+            sf::Vector2f(4546.0f, 479.0f),
+            sf::Vector2f(4738.0f, 415.0f),
+            sf::Vector2f(4994.0f, 383.0f),
+            sf::Vector2f(5122.0f, 415.0f),
+            sf::Vector2f(5250.0f, 447.0f),
+            sf::Vector2f(5630.0f, 434.0f),
+            sf::Vector2f(2322 * 2, 223 * 2)
+    };
+
+    springs = {
+
+            sf::Vector2f(3488.0f, 883.0f),
+            sf::Vector2f(3612.0f, 624.0f),
+            sf::Vector2f(3952.0f, 951.0f)
+    };
+
+    buzzers = {
+
+            sf::Vector2f(264 * 4, 195 * 4),
+            sf::Vector2f(845 * 4, 142 * 4),
+            sf::Vector2f(882 * 4, 146 * 4),
+            sf::Vector2f(1092 * 4, 117 * 4),
+            sf::Vector2f(1896 * 4, 190 * 4),
+            sf::Vector2f(1952 * 4, 164 * 4),
+            sf::Vector2f(2291 * 4, 218 * 4)
+    };
+
+    motobugs = {
+
+            sf::Vector2f(208 * 4, 232 * 4),
+            sf::Vector2f(1302 * 4, 190 * 4)
+    };
+
+    crabmeats = {
+
+            sf::Vector2f(548 * 4, 208 * 4),
+            sf::Vector2f(558 * 4, 200 * 4),
+            sf::Vector2f(2142 * 4, 287 * 4),
+            sf::Vector2f(5370, 480)
+    };
+
+    fish = {
+            {sf::Vector2f(295 * 4, 190 * 4), 265},
+            {sf::Vector2f(669 * 4, 164 * 4), 225},
+            {sf::Vector2f(690 * 4, 164 * 4), 238},
+            {sf::Vector2f(2018 * 4, 164 * 4), 240},
+            {sf::Vector2f(2031 * 4, 164 * 4), 243}
+    };
+
+    powerUps = {
+            {sf::Vector2f(144.0f * 4, 208.0f * 4), PowerUpSprite::PowerUpType::SPEED},
+            {sf::Vector2f(369.0f * 4, 196.0f * 4), PowerUpSprite::PowerUpType::HEALTH},
+            {sf::Vector2f(1196.0f * 4, 200.0f * 4), PowerUpSprite::PowerUpType::SHIELD},
+            {sf::Vector2f(2188.0f * 4, 208.0f * 4), PowerUpSprite::PowerUpType::RINGS},
+            {sf::Vector2f(2249.0f * 4, 196.0f * 4), PowerUpSprite::PowerUpType::INVINCIBILITY}
+    };
+
+    teleports = {
+            {sf::FloatRect(sf::Vector2f(6613.0f, 346.0f), sf::Vector2f(40.0f, 60.0f)), sf::Vector2f(6993.0f, 1118.0f)},
+            {sf::FloatRect(sf::Vector2f(6612.0f, 852.0f), sf::Vector2f(40.0f, 60.0f)), sf::Vector2f(6993.0f, 1118.0f)},
+            {sf::FloatRect(sf::Vector2f(6102.0f, 579.0f), sf::Vector2f(40.0f, 60.0f)), sf::Vector2f(6413.79f, 850.5f)}
+    };
+}
+
+// Scenery in the order it is baked: flowers, then bridges, then the spike art
+void LevelData::placeScenery() {
+    scenery = {
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(0.0f, 880.0f)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(256.0f, 880.0f)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(512.0f, 880.0f)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(608.0f, 800.0f)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(768.0f, 880.0f)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(1408.0f, 832.0f)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(1792.0f, 880.0f)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(548.0f * 4, 200.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(768.0f * 4, 156.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(832.0f * 4, 156.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(1008.0f * 4, 146.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(1016.0f * 4, 140.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(1028.0f * 4, 216.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(1124.0f * 4, 136.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(1164.0f * 4, 130.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(1280.0f * 4, 156.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(1412.0f * 4, 152.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(1476.0f * 4, 88.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(1536.0f * 4, 12.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(1560.0f * 4, 16.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(1600.0f * 4, 12.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(1624.0f * 4, 16.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(1664.0f * 4, 12.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(1688.0f * 4, 16.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(1792.0f * 4, 284.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(1888.0f * 4, 208.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(2096.0f * 4, 208.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(2104.0f * 4, 204.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(2176.0f * 4, 220.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(2200.0f * 4, 200.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(2304.0f * 4, 284.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(2368.0f * 4, 284.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(2432.0f * 4, 284.0f * 4)},
+            {SpriteKind::FLOWER_SHORT, sf::Vector2f(2496.0f * 4, 284.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(64.0f, 904.0f)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(96.0f, 904.0f)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(320.0f, 904.0f)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(352.0f, 904.0f)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(1312.0f, 840.0f)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(1344.0f, 840.0f)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(1440.0f, 840.0f)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(2080.0f, 840.0f)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(784.0f * 4, 162.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(792.0f * 4, 162.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(912.0f * 4, 210.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(948.0f * 4, 226.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(1096.0f * 4, 146.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(1232.0f * 4, 146.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(1268.0f * 4, 162.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(1296.0f * 4, 162.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(1304.0f * 4, 162.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(1552.0f * 4, 18.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(1576.0f * 4, 18.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(1588.0f * 4, 18.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(1616.0f * 4, 18.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(1640.0f * 4, 18.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(1652.0f * 4, 18.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(1680.0f * 4, 18.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(1704.0f * 4, 18.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(1716.0f * 4, 18.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(1744.0f * 4, 274.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(1780.0f * 4, 290.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(1824.0f * 4, 210.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(1872.0f * 4, 210.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(1896.0f * 4, 210.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(2256.0f * 4, 274.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(2292.0f * 4, 290.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(2320.0f * 4, 290.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(2328.0f * 4, 290.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(2384.0f * 4, 290.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(2392.0f * 4, 290.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(2448.0f * 4, 290.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(2456.0f * 4, 290.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(2512.0f * 4, 290.0f * 4)},
+            {SpriteKind::FLOWER_TALL, sf::Vector2f(2520.0f * 4, 290.0f * 4)}
+    };
+
+    struct Bridge {
+        float startX;
+        float startY;
+        int count;
+    };
+    const Bridge bridges[] = {
+            {272 * 4, 224 * 4, 12},
+            {656 * 4, 196 * 4, 12},
+            {2000 * 4, 196 * 4, 12}
+    };
+    for (const auto& bridge : bridges) {
+        for (int i = 0; i < bridge.count; ++i) {
+            scenery.push_back({SpriteKind::BRIDGE, sf::Vector2f(bridge.startX + i * 16, bridge.startY)});
+        }
+    }
+
+    for (const auto& pos : spikes) {
+        scenery.push_back({SpriteKind::SPIKE, pos});
+    }
+}
@@ -0,0 +1,88 @@
+#include "../include/Metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+Metrics::Histogram::Histogram(std::vector<double> upperBounds)
+        : bounds(std::move(upperBounds)), buckets(new std::atomic<uint64_t>[bounds.size() + 1]) {
+    std::sort(bounds.begin(), bounds.end());
+    for (size_t i = 0; i <= bounds.size(); ++i) {
+        buckets[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void Metrics::Histogram::observe(double value) {
+    const size_t index = static_cast<size_t>(std::lower_bound(bounds.begin(), bounds.end(), value) - bounds.begin());
+    buckets[index].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sumThousandths.fetch_add(static_cast<int64_t>(std::llround(value * 1000.0)), std::memory_order_relaxed);
+}
+
+Metrics::Entry* Metrics::find(const std::string& name) {
+    for (auto& entry : entries) {
+        if (entry.name == name) return &entry;
+    }
+    return nullptr;
+}
+
+Metrics::Counter& Metrics::counter(const std::string& name, const std::string& help) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry* entry = find(name);
+    if (!entry) {
+        entries.push_back(Entry{name, help, nullptr, nullptr, nullptr});
+        entry = &entries.back();
+    }
+    if (!entry->counter) entry->counter = std::make_unique<Counter>();
+    return *entry->counter;
+}
+
+Metrics::Gauge& Metrics::gauge(const std::string& name, const std::string& help) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry* entry = find(name);
+    if (!entry) {
+        entries.push_back(Entry{name, help, nullptr, nullptr, nullptr});
+        entry = &entries.back();
+    }
+    if (!entry->gauge) entry->gauge = std::make_unique<Gauge>();
+    return *entry->gauge;
+}
+
+Metrics::Histogram& Metrics::histogram(const std::string& name, const std::string& help, std::vector<double> upperBounds) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry* entry = find(name);
+    if (!entry) {
+        entries.push_back(Entry{name, help, nullptr, nullptr, nullptr});
+        entry = &entries.back();
+    }
+    if (!entry->histogram) entry->histogram = std::make_unique<Histogram>(std::move(upperBounds));
+    return *entry->histogram;
+}
+
+// Histogram buckets come out cumulative, as the format expects
+std::string Metrics::exposition() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::ostringstream out;
+    for (const auto& entry : entries) {
+        out << "# HELP " << entry.name << " " << entry.help << "\n";
+        if (entry.counter) {
+            out << "# TYPE " << entry.name << " counter\n";
+            out << entry.name << " " << entry.counter->get() << "\n";
+        } else if (entry.gauge) {
+            out << "# TYPE " << entry.name << " gauge\n";
+            out << entry.name << " " << entry.gauge->get() << "\n";
+        } else if (entry.histogram) {
+            const Histogram& histogram = *entry.histogram;
+            out << "# TYPE " << entry.name << " histogram\n";
+            uint64_t cumulative = 0;
+            for (size_t i = 0; i < histogram.getBounds().size(); ++i) {
+                cumulative += histogram.getBucket(i);
+                out << entry.name << "_bucket{le=\"" << histogram.getBounds()[i] << "\"} " << cumulative << "\n";
+            }
+            cumulative += histogram.getBucket(histogram.getBounds().size());
+            out << entry.name << "_bucket{le=\"+Inf\"} " << cumulative << "\n";
+            out << entry.name << "_sum " << histogram.getSum() << "\n";
+            out << entry.name << "_count " << histogram.getCount() << "\n";
+        }
+    }
+    return out.str();
+}
@@ -0,0 +1,110 @@
+#include "../include/MetricsExporter.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    constexpr int POLL_MS = 100;          // how often the thread looks for scrapers and stop()
+    constexpr int REQUEST_WAIT_MS = 200;  // a scraper gets this long to send its request
+}
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+}
+
+bool MetricsExporter::start(const std::string& path, unsigned short port, float intervalSeconds) {
+    if (thread.joinable()) return true;
+
+    filePath = path;
+    interval = intervalSeconds;
+    if (port != 0) {
+        if (listener.listen(port, sf::IpAddress::LocalHost) != sf::Socket::Status::Done) {
+            std::cerr << "fail metrics port " << port << std::endl;
+            return false;
+        }
+        listening = true;
+    }
+    if (filePath.empty() && !listening) return false;
+
+    stopping = false;
+    thread = std::thread(&MetricsExporter::run, this);
+    return true;
+}
+
+// Writes the file one last time on the way out, so it ends on the final counts
+void MetricsExporter::stop() {
+    if (!thread.joinable()) return;
+    stopping = true;
+    thread.join();
+    if (!filePath.empty()) writeFile();
+    if (listening) {
+        listener.close();
+        listening = false;
+    }
+}
+
+void MetricsExporter::run() {
+    sf::SocketSelector selector;
+    if (listening) selector.add(listener);
+
+    sf::Clock sinceWrite;
+    if (!filePath.empty()) writeFile();
+
+    while (!stopping) {
+        if (listening) {
+            if (selector.wait(sf::milliseconds(POLL_MS)) && selector.isReady(listener)) {
+                serve();
+            }
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(POLL_MS));
+        }
+
+        if (!filePath.empty() && sinceWrite.getElapsedTime().asSeconds() >= interval) {
+            writeFile();
+            sinceWrite.restart();
+        }
+    }
+}
+
+bool MetricsExporter::writeFile() const {
+    const std::string temporary = filePath + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::trunc);
+        if (!(out << metrics.exposition())) {
+            std::cerr << "fail " << temporary << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, filePath, error);
+    if (error) {
+        std::cerr << "fail " << filePath << std::endl;
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
+
+// One scrape per connection: whatever was asked, the answer is the exposition
+void MetricsExporter::serve() {
+    sf::TcpSocket client;
+    if (listener.accept(client) != sf::Socket::Status::Done) return;
+
+    sf::SocketSelector request;
+    request.add(client);
+    if (request.wait(sf::milliseconds(REQUEST_WAIT_MS))) {
+        char buffer[1024];
+        size_t received = 0;
+        (void)client.receive(buffer, sizeof(buffer), received);
+    }
+
+    const std::string body = metrics.exposition();
+    const std::string response = "HTTP/1.0 200 OK\r\n"
+                                 "Content-Type: text/plain; version=0.0.4\r\n"
+                                 "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                                 "Connection: close\r\n\r\n" + body;
+    (void)client.send(response.data(), response.size());
+    client.disconnect();
+}
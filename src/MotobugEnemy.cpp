@@ -1,45 +1,22 @@
 #include "../include/MotobugEnemy.h"
-#include "SoundManager.h"
-#include <iostream>
+#include "../include/LevelData.h"
 #include <cmath>
 
-MotobugEnemy::MotobugEnemy(const sf::Vector2f& pos)
-        : BaseSprite(pos, true)
+MotobugEnemy::MotobugEnemy(const SpriteArchetypes& types, const sf::Vector2f& pos)
+        : BaseSprite(types.get(SpriteKind::MOTOBUG), pos)
         , originalX(pos.x)
         , isActive(true)
         , movingRight(false)
 {
-    if (!texture.loadFromFile("./assets/enemies_sheet_fixed.png")) {
-        std::cerr << "fail" << std::endl;
-        return;
-    }
-
-    sprite.setTexture(texture);
-    initializeFrames();
-    sprite.setTextureRect(frames[0]);
-    sprite.setPosition(position);
-    frameTime = 0.1f;
+    smokeAnimation.play(*archetype.actionClip, true);
 
     sprite.setScale(sf::Vector2f(1.f, 1.f));
     sprite.setOrigin(sf::Vector2f(0.f, 0.f));
-
-    SoundManager::getInstance().loadSound("badnik-death", "./assets/badnik-death.mp3");
 }
 
 void MotobugEnemy::initializeFrames() {
-
-    frames = {
-            sf::IntRect(sf::Vector2i(157, 102), sf::Vector2i(40, 32)),
-            sf::IntRect(sf::Vector2i(213, 102), sf::Vector2i(40, 32)),
-            sf::IntRect(sf::Vector2i(157, 142), sf::Vector2i(40, 32)),
-            sf::IntRect(sf::Vector2i(213, 142), sf::Vector2i(40, 32))
-    };
-
-    smokeFrames = {
-            sf::IntRect(sf::Vector2i(269, 102), sf::Vector2i(8, 8)),
-            sf::IntRect(sf::Vector2i(269, 118), sf::Vector2i(8, 8)),
-            sf::IntRect(sf::Vector2i(269, 134), sf::Vector2i(8, 8))
-    };
+    playClip(*archetype.clip, true);
+    smokeAnimation.play(*archetype.actionClip, true);
 }
 
 void MotobugEnemy::update(float deltaTime) {
@@ -53,18 +30,7 @@ void MotobugEnemy::update(float deltaTime) {
         return;
     }
 
-    smokeAnimTimer += deltaTime;
-    if (smokeAnimTimer >= SMOKE_FRAME_TIME) {
-        smokeAnimTimer = 0;
-        currentSmokeFrame = (currentSmokeFrame + 1) % smokeFrames.size();
-    }
-
-    animationTimer += deltaTime;
-    if (animationTimer >= frameTime) {
-        animationTimer = 0;
-        currentFrame = (currentFrame + 1) % frames.size();
-        sprite.setTextureRect(frames[currentFrame]);
-    }
+    smokeAnimation.advance(deltaTime);
 
 
     if (pauseTimer > 0) {
@@ -134,18 +100,18 @@ void MotobugEnemy::updatePatrolMovement(float deltaTime) {
     sprite.setPosition(position);
 }
 
-void MotobugEnemy::render(sf::RenderWindow& window) const {
+void MotobugEnemy::render(RenderSnapshot& target) const {
     if (!isActive) {
         if (freedAnimal) {
-            freedAnimal->render(window);
+            freedAnimal->render(target);
         }
         return;
     }
-    window.draw(sprite);
+    target.draw(sprite);
 
 
-    sf::Sprite smokeSprite(texture);
-    smokeSprite.setTextureRect(smokeFrames[currentSmokeFrame]);
+    sf::Sprite smokeSprite(*archetype.texture);
+    smokeSprite.setTextureRect(smokeAnimation.frameRect());
 
     sf::Vector2f smokePos = position;
     if (movingRight) {
@@ -156,18 +122,18 @@ void MotobugEnemy::render(sf::RenderWindow& window) const {
     smokePos.y += 11.0f;
 
     smokeSprite.setPosition(smokePos);
-    window.draw(smokeSprite);
+    target.draw(smokeSprite);
 }
 
-void MotobugEnemy::die() {
+void MotobugEnemy::die(const EngineContext& context) {
     if (isActive) {
         isActive = false;
 
-        SoundManager::getInstance().playSound("badnik-death");
+        context.play(archetype.sound);
 
 
-        bool moveRight = (std::rand() % 2) == 0;
-        freedAnimal = std::make_unique<AnimalSprite>(position, moveRight);
+        bool moveRight = context.random->below(2) == 0;
+        freedAnimal = std::make_unique<AnimalSprite>(context.level->archetypes, position, moveRight);
         if (freedAnimal && collisionMap) {
             freedAnimal->setCollisionMap(collisionMap);
         }
@@ -203,12 +169,8 @@ void MotobugEnemy::reset() {
     sprite.setScale(sf::Vector2f(1.f, 1.f));
     sprite.setOrigin(sf::Vector2f(0.f, 0.f));
     sprite.setPosition(position);
-    sprite.setTextureRect(frames[0]);
+    initializeFrames();
     movementTimer = 0.0f;
     pauseTimer = 0.0f;
-    animationTimer = 0.0f;
-    smokeAnimTimer = 0.0f;
-    currentFrame = 0;
-    currentSmokeFrame = 0;
     freedAnimal.reset();
 }
\ No newline at end of file
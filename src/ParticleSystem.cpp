@@ -0,0 +1,228 @@
+#include "../include/ParticleSystem.h"
+#include "../include/SpriteArchetype.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr float DEG_TO_RAD = 3.14159265f / 180.0f;
+
+    uint8_t lerpChannel(uint8_t from, uint8_t to, float t) {
+        return static_cast<uint8_t>(static_cast<float>(from) + (static_cast<float>(to) - static_cast<float>(from)) * t);
+    }
+
+    struct EmitterTable {
+        std::array<ParticleEmitter, static_cast<size_t>(ParticleEffect::COUNT)> emitters;
+
+        EmitterTable() {
+            // the ring's own collect clip, played once where the ring was; the
+            // texture and clip are filled in per level by setArchetypes()
+            auto& sparkle = at(ParticleEffect::RING_SPARKLE);
+            sparkle.lifetime = 0.4f;
+
+            auto& explosion = at(ParticleEffect::BADNIK_EXPLOSION);
+            explosion.count = 14;
+            explosion.lifetime = 0.45f;
+            explosion.speedMin = 60.0f;
+            explosion.speedMax = 170.0f;
+            explosion.gravity = 320.0f;
+            explosion.spawnRadius = 6.0f;
+            explosion.size = 3.0f;
+            explosion.startColor = sf::Color(255, 255, 200);
+            explosion.endColor = sf::Color(255, 90, 0, 0);
+
+            auto& stars = at(ParticleEffect::INVINCIBILITY_STARS);
+            stars.rate = 40.0f;
+            stars.lifetime = 0.6f;
+            stars.speedMin = 10.0f;
+            stars.speedMax = 35.0f;
+            stars.gravity = 40.0f;
+            stars.spawnRadius = 18.0f;
+            stars.size = 2.0f;
+            stars.startColor = sf::Color(255, 255, 255);
+            stars.endColor = sf::Color(255, 230, 60, 0);
+
+            auto& shield = at(ParticleEffect::SHIELD);
+            shield.rate = 90.0f;
+            shield.lifetime = 0.25f;
+            shield.spawnRadius = 22.0f;
+            shield.spawnOnEdge = true;
+            shield.size = 2.0f;
+            shield.startColor = sf::Color(150, 210, 255, 220);
+            shield.endColor = sf::Color(40, 110, 255, 0);
+        }
+
+        ParticleEmitter& at(ParticleEffect effect) { return emitters[static_cast<size_t>(effect)]; }
+    };
+}
+
+const ParticleEmitter& ParticleEmitter::get(ParticleEffect effect) {
+    static const EmitterTable table;
+    return table.emitters[static_cast<size_t>(effect)];
+}
+
+
+// Every array is sized once up front; emitting never allocates
+ParticleSystem::ParticleSystem()
+        : posX(CAPACITY), posY(CAPACITY), velX(CAPACITY), velY(CAPACITY),
+          gravity(CAPACITY), age(CAPACITY), lifetime(CAPACITY), effects(CAPACITY)
+{
+    for (size_t i = 0; i < emitters.size(); ++i) {
+        emitters[i] = ParticleEmitter::get(static_cast<ParticleEffect>(i));
+    }
+}
+
+void ParticleSystem::setArchetypes(const SpriteArchetypes& types) {
+    const auto& ring = types.get(SpriteKind::RING);
+    auto& sparkle = emitters[static_cast<size_t>(ParticleEffect::RING_SPARKLE)];
+    sparkle.texture = ring.texture;
+    sparkle.clip = ring.actionClip;
+}
+
+void ParticleSystem::emit(ParticleEffect effect, const sf::Vector2f& position) {
+    const auto& emitter = emitters[static_cast<size_t>(effect)];
+    for (int i = 0; i < emitter.count; ++i) {
+        spawn(static_cast<uint8_t>(effect), emitter, position);
+    }
+}
+
+// Continuous emission at the emitter's rate, carrying fractional particles between frames
+void ParticleSystem::stream(ParticleEffect effect, const sf::Vector2f& position, float deltaTime) {
+    const auto& emitter = emitters[static_cast<size_t>(effect)];
+    float& carry = streamCarry[static_cast<size_t>(effect)];
+    carry += emitter.rate * deltaTime;
+    while (carry >= 1.0f) {
+        spawn(static_cast<uint8_t>(effect), emitter, position);
+        carry -= 1.0f;
+    }
+}
+
+void ParticleSystem::clear() {
+    count = 0;
+    streamCarry.fill(0.0f);
+}
+
+// A full pool drops new particles rather than stealing live ones
+void ParticleSystem::spawn(uint8_t effect, const ParticleEmitter& emitter, const sf::Vector2f& position) {
+    if (count >= CAPACITY) return;
+
+    float offsetX = 0.0f;
+    float offsetY = 0.0f;
+    if (emitter.spawnRadius > 0.0f) {
+        const float angle = random.range(0.0f, 360.0f) * DEG_TO_RAD;
+        const float radius = emitter.spawnOnEdge ? emitter.spawnRadius : random.range(0.0f, emitter.spawnRadius);
+        offsetX = std::cos(angle) * radius;
+        offsetY = std::sin(angle) * radius;
+    }
+
+    const float direction = random.range(emitter.angleMin, emitter.angleMax) * DEG_TO_RAD;
+    const float speed = random.range(emitter.speedMin, emitter.speedMax);
+
+    const size_t i = count++;
+    posX[i] = position.x + offsetX;
+    posY[i] = position.y + offsetY;
+    velX[i] = std::cos(direction) * speed;
+    velY[i] = std::sin(direction) * speed;
+    gravity[i] = emitter.gravity;
+    age[i] = 0.0f;
+    lifetime[i] = emitter.lifetime;
+    effects[i] = effect;
+}
+
+// Moves the last live particle into the freed slot
+void ParticleSystem::kill(size_t index) {
+    const size_t last = --count;
+    posX[index] = posX[last];
+    posY[index] = posY[last];
+    velX[index] = velX[last];
+    velY[index] = velY[last];
+    gravity[index] = gravity[last];
+    age[index] = age[last];
+    lifetime[index] = lifetime[last];
+    effects[index] = effects[last];
+}
+
+// Integration is branch-free over plain float arrays so the compiler can vectorise
+// it; expired particles are swept out in a second pass
+void ParticleSystem::update(float deltaTime) {
+    const size_t n = count;
+    float* px = posX.data();
+    float* py = posY.data();
+    float* vx = velX.data();
+    float* vy = velY.data();
+    const float* g = gravity.data();
+    float* a = age.data();
+
+    for (size_t i = 0; i < n; ++i) {
+        vy[i] += g[i] * deltaTime;
+        px[i] += vx[i] * deltaTime;
+        py[i] += vy[i] * deltaTime;
+        a[i] += deltaTime;
+    }
+
+    size_t i = 0;
+    while (i < count) {
+        if (age[i] >= lifetime[i]) {
+            kill(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+ParticleSystem::Batch& ParticleSystem::batchFor(const sf::Texture* texture) {
+    for (auto& batch : batches) {
+        if (batch.texture == texture) return batch;
+    }
+    batches.push_back(Batch{texture, sf::VertexArray(sf::PrimitiveType::Triangles)});
+    return batches.back();
+}
+
+// Builds the visible particles into one vertex array per texture and draws each once
+void ParticleSystem::render(RenderSnapshot& target) {
+    for (auto& batch : batches) {
+        batch.vertices.clear();
+    }
+    if (count == 0) return;
+
+    const sf::View& view = target.getView();
+    const sf::FloatRect visible(view.getCenter() - view.getSize() / 2.0f, view.getSize());
+
+    for (size_t i = 0; i < count; ++i) {
+        if (!visible.contains(sf::Vector2f(posX[i], posY[i]))) continue;
+
+        const auto& emitter = emitters[effects[i]];
+        const float t = std::min(1.0f, age[i] / lifetime[i]);
+
+        sf::Vector2f size(emitter.size, emitter.size);
+        sf::Vector2f tex;
+        sf::Color color = sf::Color::White;
+        if (emitter.clip) {
+            const auto& frames = emitter.clip->frames;
+            const size_t frame = std::min(frames.size() - 1, static_cast<size_t>(t * static_cast<float>(frames.size())));
+            size = sf::Vector2f(frames[frame].rect.size);
+            tex = sf::Vector2f(frames[frame].rect.position);
+        } else {
+            color = sf::Color(lerpChannel(emitter.startColor.r, emitter.endColor.r, t),
+                              lerpChannel(emitter.startColor.g, emitter.endColor.g, t),
+                              lerpChannel(emitter.startColor.b, emitter.endColor.b, t),
+                              lerpChannel(emitter.startColor.a, emitter.endColor.a, t));
+        }
+
+        const sf::Vector2f topLeft(posX[i] - size.x / 2.0f, posY[i] - size.y / 2.0f);
+        const sf::Vector2f corners[6] = {
+                {0.f, 0.f}, {size.x, 0.f}, {0.f, size.y},
+                {0.f, size.y}, {size.x, 0.f}, {size.x, size.y}
+        };
+        auto& vertices = batchFor(emitter.texture).vertices;
+        for (const auto& corner : corners) {
+            vertices.append(sf::Vertex{topLeft + corner, color, emitter.texture ? tex + corner : sf::Vector2f()});
+        }
+    }
+
+    for (const auto& batch : batches) {
+        if (batch.vertices.getVertexCount() == 0) continue;
+        sf::RenderStates states;
+        states.texture = batch.texture;
+        target.draw(batch.vertices, states);
+    }
+}
@@ -0,0 +1,274 @@
+#include "../include/PcmCache.h"
+#include "../include/AudioMixer.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace {
+    constexpr char MAGIC[4] = {'P', 'C', 'M', 'C'};
+    constexpr size_t DATA_ALIGNMENT = 16;
+
+    // Fixed part of the file: magic, version, the mixer format the samples were
+    // converted to, and how many entries follow
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t sampleRate;
+        uint32_t channels;
+        uint32_t entryCount;
+        uint32_t reserved;
+    };
+
+    // Follows its path bytes in the entry table; offset is from the start of the file
+    struct EntryRecord {
+        int64_t mtime;
+        uint64_t size;
+        uint64_t hash;
+        uint64_t offset;
+        uint64_t length;
+    };
+
+    template <typename T>
+    bool readValue(const uint8_t* data, size_t size, size_t& cursor, T& value) {
+        if (cursor + sizeof(T) > size) return false;
+        std::memcpy(&value, data + cursor, sizeof(T));
+        cursor += sizeof(T);
+        return true;
+    }
+
+    template <typename T>
+    void writeValue(std::vector<uint8_t>& out, const T& value) {
+        const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+}
+
+PcmCache::PcmCache(std::string path) : path(std::move(path)) {
+    if (!load()) {
+        entries.clear();
+        file.close();
+    }
+}
+
+// Maps the cache and indexes it. Any mismatch in magic, version or mixer format
+// throws the whole file away; it is rebuilt on the next save
+bool PcmCache::load() {
+    if (!file.open(path)) return false;
+
+    const uint8_t* data = file.data();
+    const size_t size = file.size();
+    size_t cursor = 0;
+
+    Header header{};
+    if (!readValue(data, size, cursor, header)) return false;
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+        header.sampleRate != AudioMixer::SAMPLE_RATE || header.channels != AudioMixer::CHANNELS) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < header.entryCount; ++i) {
+        uint32_t pathLength = 0;
+        if (!readValue(data, size, cursor, pathLength) || cursor + pathLength > size) return false;
+        std::string source(reinterpret_cast<const char*>(data + cursor), pathLength);
+        cursor += pathLength;
+
+        EntryRecord record{};
+        if (!readValue(data, size, cursor, record)) return false;
+        if (record.offset % DATA_ALIGNMENT != 0 || record.offset > size ||
+            record.length > (size - record.offset) / sizeof(float)) {
+            return false;
+        }
+
+        Entry entry;
+        entry.stamp = {record.mtime, record.size, record.hash};
+        entry.samples = reinterpret_cast<const float*>(data + record.offset);
+        entry.length = static_cast<size_t>(record.length);
+        entry.mapped = true;
+        entries[source] = entry;
+    }
+    return true;
+}
+
+bool PcmCache::readStamp(const std::string& source, Stamp& stamp) {
+    std::error_code error;
+    const auto time = std::filesystem::last_write_time(source, error);
+    if (error) return false;
+    const auto size = std::filesystem::file_size(source, error);
+    if (error) return false;
+
+    stamp.mtime = static_cast<int64_t>(time.time_since_epoch().count());
+    stamp.size = static_cast<uint64_t>(size);
+    return true;
+}
+
+// FNV-1a over the raw file; only needed when the mtime alone says "changed"
+uint64_t PcmCache::hashFile(const std::string& source) {
+    std::ifstream in(source, std::ios::binary);
+    uint64_t hash = 14695981039346656037ull;
+    char buffer[4096];
+    while (in.read(buffer, sizeof(buffer)) || in.gcount() > 0) {
+        for (std::streamsize i = 0; i < in.gcount(); ++i) {
+            hash ^= static_cast<uint8_t>(buffer[i]);
+            hash *= 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+// On a hit, samples point straight into the mapped file
+bool PcmCache::find(const std::string& source, const float*& samples, size_t& length) {
+    auto it = entries.find(source);
+    if (it == entries.end()) return false;
+
+    Stamp current;
+    if (!readStamp(source, current)) return false;
+
+    Entry& entry = it->second;
+    if (current.size != entry.stamp.size) return false;
+    if (current.mtime != entry.stamp.mtime) {
+        if (hashFile(source) != entry.stamp.hash) return false;
+        entry.stamp.mtime = current.mtime;
+        dirty = true;
+    }
+
+    samples = entry.samples;
+    length = entry.length;
+    return true;
+}
+
+bool PcmCache::find(const std::string& source, uint64_t size, uint64_t hash, const float*& samples, size_t& length) {
+    auto it = entries.find(source);
+    if (it == entries.end() || it->second.stamp.size != size || it->second.stamp.hash != hash) return false;
+
+    samples = it->second.samples;
+    length = it->second.length;
+    return true;
+}
+
+// What the mapping holds for source, without checking it against the file
+bool PcmCache::lookup(const std::string& source, const float*& samples, size_t& length) const {
+    auto it = entries.find(source);
+    if (it == entries.end()) return false;
+    samples = it->second.samples;
+    length = it->second.length;
+    return true;
+}
+
+void PcmCache::store(const std::string& source, uint64_t size, uint64_t hash, const float* samples, size_t length) {
+    Entry entry;
+    entry.stamp = {0, size, hash};
+    entry.samples = samples;
+    entry.length = length;
+    entries[source] = entry;
+    dirty = true;
+}
+
+// Remembers freshly decoded samples for the next save; they must outlive it
+void PcmCache::store(const std::string& source, const float* samples, size_t length) {
+    Entry entry;
+    if (!readStamp(source, entry.stamp)) return;
+    entry.stamp.hash = hashFile(source);
+    entry.samples = samples;
+    entry.length = length;
+    entries[source] = entry;
+    dirty = true;
+}
+
+// Writes every entry to a temporary file and swaps it in, so the mapping we are
+// still reading from is never written to
+bool PcmCache::save() {
+    if (!dirty) return true;
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.sampleRate = AudioMixer::SAMPLE_RATE;
+    header.channels = AudioMixer::CHANNELS;
+    header.entryCount = static_cast<uint32_t>(entries.size());
+
+    size_t tableSize = sizeof(Header);
+    for (const auto& [source, entry] : entries) {
+        tableSize += sizeof(uint32_t) + source.size() + sizeof(EntryRecord);
+    }
+
+    std::vector<uint8_t> out;
+    writeValue(out, header);
+
+    uint64_t offset = (tableSize + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+    for (const auto& [source, entry] : entries) {
+        writeValue(out, static_cast<uint32_t>(source.size()));
+        out.insert(out.end(), source.begin(), source.end());
+
+        EntryRecord record{entry.stamp.mtime, entry.stamp.size, entry.stamp.hash, offset, entry.length};
+        writeValue(out, record);
+
+        const uint64_t bytes = entry.length * sizeof(float);
+        offset = (offset + bytes + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+    }
+
+    for (const auto& [source, entry] : entries) {
+        out.resize((out.size() + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT, 0);
+        const auto* bytes = reinterpret_cast<const uint8_t*>(entry.samples);
+        out.insert(out.end(), bytes, bytes + entry.length * sizeof(float));
+    }
+
+    // Shipped builds have only the pack, so the assets folder may not exist yet
+    const auto parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::error_code ignored;
+        std::filesystem::create_directories(parent, ignored);
+    }
+
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+        if (!stream.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()))) {
+            std::cerr << "fail " << temporary << std::endl;
+            return false;
+        }
+    }
+
+    // Windows will not replace a file that is still mapped, so the mapping goes
+    // first and is made again from whichever file ends up in place
+    auto kept = std::move(entries);
+    entries.clear();
+    file.close();
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::cerr << "fail " << path << std::endl;
+        std::error_code ignored;
+        std::filesystem::remove(temporary, ignored);
+    }
+
+    if (!load()) {
+        entries.clear();
+        file.close();
+    }
+    if (!error) {
+        dirty = false;
+        return true;
+    }
+
+    // The old file is still in place. Entries read from it point into its new
+    // mapping, or go if it no longer maps; the ones just stored are kept as they
+    // are for the next save to try again
+    for (auto it = kept.begin(); it != kept.end();) {
+        Entry& entry = it->second;
+        if (entry.mapped) {
+            const auto reloaded = entries.find(it->first);
+            if (reloaded == entries.end()) {
+                it = kept.erase(it);
+                continue;
+            }
+            entry.samples = reloaded->second.samples;
+            entry.length = reloaded->second.length;
+        }
+        ++it;
+    }
+    entries = std::move(kept);
+    return false;
+}
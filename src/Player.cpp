@@ -1,14 +1,13 @@
 #include "../include/Player.h"
 #include "../include/FishEnemy.h"
-#include "SoundManager.h"
 #include <iostream>
 #include <cmath>
 
-Player::Player() : sprite(texture), animState(IDLE), animSwitch(true) {
+Player::Player(const sf::Texture& sheet, const EngineContext& context)
+        : sprite(sheet), animState(IDLE), animSwitch(true), context(context) {
+    this->initAnimation();
     this->initPlayer();
     this->initPhysics();
-    this->initAnimation();
-    this->initSounds();
 }
 
 
@@ -24,32 +23,18 @@ void Player::loseRings() {
 
 
 void Player::initPlayer() {
-    if (!texture.loadFromFile("./assets/sonic_sheet_fixed.png")) {
-        std::cerr << "fail" << std::endl;
-        return;
-    }
-
-    this->frame = sf::IntRect({ 27, 39 }, { 32, 40 });
-    this->sprite.setTexture(texture);
-    this->sprite.setTextureRect(frame);
     normalSize = getSpriteSize();
-    auto& soundManager = SoundManager::getInstance();
-    soundManager.loadSound("jump", "./assets/jump.mp3");
-    soundManager.loadSound("bumper", "./assets/bumper.mp3");
-    soundManager.loadSound("ring-collect", "./assets/ring-collect.mp3");
 }
 
-// Gets the collision bounds rectangle for the player
+// Gets the collision bounds rectangle for the player, sized by the current frame's hitbox
 sf::FloatRect Player::getCollisionBounds() const {
     sf::Vector2f pos = sprite.getPosition();
-    sf::Vector2f size = getSpriteSize();
+    const sf::IntRect& hitbox = animation.hitbox();
+    sf::Vector2f scale = sprite.getScale();
+    sf::Vector2f size(hitbox.size.x * std::abs(scale.x), hitbox.size.y * scale.y);
 
-    if (animState == PUSHING) {
-        size.x = 24.0f;
-    }
 
-
-    float scaleX = sprite.getScale().x;
+    float scaleX = scale.x;
     float originX = (scaleX < 0) ? size.x : 0;
 
     return sf::FloatRect(sf::Vector2f(pos.x - originX, pos.y), size);
@@ -120,20 +105,20 @@ void Player::updateMovement() {
 void Player::handleGodModeMovement() {
     const float godModeSpeed = 5.0f;
 
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A)) {
+    if (input.left) {
         velocity.x = -godModeSpeed;
     }
-    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D)) {
+    else if (input.right) {
         velocity.x = godModeSpeed;
     }
     else {
         velocity.x = 0;
     }
 
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W)) {
+    if (input.up) {
         velocity.y = -godModeSpeed;
     }
-    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::S)) {
+    else if (input.down) {
         velocity.y = godModeSpeed;
     }
     else {
@@ -146,10 +131,10 @@ void Player::handleGodModeMovement() {
 }
 
 void Player::handleGroundMovement(bool& isPushingWall) {
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D)) {
+    if (input.right) {
         handleRightMovement(isPushingWall);
     }
-    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A)) {
+    else if (input.left) {
         handleLeftMovement();
     }
     else {
@@ -157,10 +142,10 @@ void Player::handleGroundMovement(bool& isPushingWall) {
     }
 
     if (std::abs(groundSpeed) < 0.1f && std::abs(velocity.y) < 0.1f && animState == IDLE) {
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W)) {
+        if (input.up) {
             animState = LOOKING_UP;
         }
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::S)) {
+        if (input.down) {
             animState = CURLING_DOWN;
         }
     }
@@ -198,12 +183,10 @@ void Player::bounceFromSpring() {
     velocity.y = SPRING_FORCE;
     isJumping = true;
     isOnGround = false;
-    animState = JUMPING;
-    frame = sf::IntRect({27, 407}, {32, 32});
-    sprite.setTextureRect(frame);
+    enterAnimationState(JUMPING);
 
 
-    SoundManager::getInstance().playSound("bumper");
+    context.play(SoundEffect::BUMPER);
 }
 
 
@@ -212,7 +195,7 @@ void Player::handleWallPush(bool& isPushingWall) {
     isPushingWall = true;
     if (animState != PUSHING) {
         sf::FloatRect currentBounds = getCollisionBounds();
-        animState = PUSHING;
+        enterAnimationState(PUSHING);
         sf::FloatRect newBounds = getCollisionBounds();
         float adjustment = (newBounds.size.x - currentBounds.size.x);
         sprite.setPosition(sf::Vector2f(sprite.getPosition().x - adjustment, sprite.getPosition().y));
@@ -271,7 +254,7 @@ void Player::handleLeftMovement() {
 void Player::handleNoMovement() {
     if (animState == PUSHING) {
         sf::FloatRect currentBounds = getCollisionBounds();
-        animState = IDLE;
+        enterAnimationState(IDLE);
         sf::FloatRect newBounds = getCollisionBounds();
         float adjustment = (newBounds.size.x - currentBounds.size.x);
         sprite.setPosition(sf::Vector2f(sprite.getPosition().x - adjustment, sprite.getPosition().y));
@@ -289,17 +272,17 @@ void Player::handleNoMovement() {
 
 void Player::handleAirMovement() {
     isSkidding = false;
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A)) {
+    if (input.left) {
         velocity.x = std::max(velocity.x - AIR_ACCELERATION, -currentMaxSpeed);
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D)) {
+    if (input.right) {
         velocity.x = std::min(velocity.x + AIR_ACCELERATION, currentMaxSpeed);
     }
 }
 
 
 void Player::handleJumping() {
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Space)) {
+    if (input.jump) {
         if (!jumpButtonHeld && !isJumping && isOnGround) {
             startJump();
         }
@@ -317,10 +300,9 @@ void Player::startJump() {
     jumpButtonHeld = true;
     velocity.y = JUMP_FORCE;
     animState = JUMPING;
-    frame = sf::IntRect({27, 407}, {32, 32});
     groundSpeed = velocity.x;
 
-    SoundManager::getInstance().playSound("jump");
+    context.play(SoundEffect::JUMP);
 }
 
 void Player::updateMovementAnimation(bool isPushingWall) {
@@ -352,62 +334,36 @@ void Player::updateSpriteDirection(bool facingRight) {
 
 
 
-void Player::updateAnimation() {
-    static PLAYER_ANIMATION_STATES previousState = static_cast<PLAYER_ANIMATION_STATES>(this->animState);
+// Picks the clip for the current state and advances it. Curling down changes the
+// sprite height, so entering or leaving it keeps Sonic's feet where they were
+void Player::updateAnimation(float deltaTime) {
+    if (this->animState != IDLE) {
+        idleTime = 0.0f;
+    }
 
-    if (this->animState == IDLE) {
-        if (previousState == CURLING_DOWN) {
-            float oldBottom = sprite.getPosition().y + sprite.getGlobalBounds().size.y;
-            this->frame = sf::IntRect({27, 39}, {32, 40});
-            this->sprite.setTextureRect(frame);
-            float newHeight = sprite.getGlobalBounds().size.y;
-            sprite.setPosition(sf::Vector2f(sprite.getPosition().x, oldBottom - newHeight));
-        }
+    short clipState = this->animState;
+    if (clipState == IDLE && idleTime > 5.0f) {
+        clipState = BORED;
+    }
 
-        if (timer.getElapsedTime().asSeconds() >= 0.5f || this->getAnimationSwitch()) {
-            if (idleClock.getElapsedTime().asSeconds() > 5.0f) {
-                static int frameIndex = 0;
-                switch (frameIndex) {
-                    case 0: this->frame = sf::IntRect({59 + 54, 39}, {32, 40}); break;
-                    case 1: this->frame = sf::IntRect({59 + 54 + 32 + 38, 39}, {32, 40}); break;
-                    case 2: this->frame = sf::IntRect({59 + 54 + 2 * 32 + 2 * 38, 39}, {32, 40}); break;
-                    case 3: this->frame = sf::IntRect({59 + 54 + 3 * 32 + 3 * 38, 39}, {32, 40}); break;
-                }
-                if (frameIndex < 3) frameIndex++;
-                else if (frameIndex == 3) frameIndex = 2;
-            } else {
-                this->frame = sf::IntRect({27, 39}, {32, 40});
-            }
-            this->timer.restart();
-            this->sprite.setTextureRect(this->frame);
-        }
+    bool frameChanged = false;
+    if (const AnimationClip* clip = stateClips[clipState]) {
+        frameChanged = animation.play(*clip);
     }
-    else if (this->animState == JUMPING) {
-        if (timer.getElapsedTime().asSeconds() >= 0.05f || this->getAnimationSwitch()) {
-            static int jumpFrameIndex = 0;
-            switch (jumpFrameIndex % 5) {
-                case 0: this->frame = sf::IntRect({27, 407}, {32, 32}); break;
-                case 1: this->frame = sf::IntRect({97, 407}, {32, 32}); break;
-                case 2: this->frame = sf::IntRect({167, 407}, {32, 32}); break;
-                case 3: this->frame = sf::IntRect({237, 407}, {32, 32}); break;
-                case 4: this->frame = sf::IntRect({307, 407}, {32, 32}); break;
-            }
-            jumpFrameIndex++;
-            this->timer.restart();
-            this->sprite.setTextureRect(this->frame);
+    frameChanged = animation.advance(deltaTime) || frameChanged;
+    frameChanged = this->getAnimationSwitch() || frameChanged;
+
+    if (frameChanged) {
+        bool anchorFeet = (this->animState == CURLING_DOWN) != (previousAnimState == CURLING_DOWN);
+        float oldBottom = sprite.getPosition().y + sprite.getGlobalBounds().size.y;
+        this->sprite.setTextureRect(animation.frameRect());
+        if (anchorFeet) {
+            float newHeight = sprite.getGlobalBounds().size.y;
+            sprite.setPosition(sf::Vector2f(sprite.getPosition().x, oldBottom - newHeight));
         }
     }
-    else if (this->animState == SKIDDING) {
-        if (timer.getElapsedTime().asSeconds() >= 0.1f || this->getAnimationSwitch()) {
-            static int frameIndex = 0;
-            switch (frameIndex % 2) {
-                case 0: this->frame = sf::IntRect({463, 131}, {32, 40}); break;
-                case 1: this->frame = sf::IntRect({525, 131}, {40, 40}); break;
-            }
-            frameIndex++;
-            this->timer.restart();
-            this->sprite.setTextureRect(this->frame);
-        }
+
+    if (this->animState == SKIDDING) {
         if (groundSpeed > 0) {
             this->sprite.setScale({-1.f, 1.f});
             this->sprite.setOrigin({this->sprite.getGlobalBounds().size.x, 0.f});
@@ -416,63 +372,18 @@ void Player::updateAnimation() {
             this->sprite.setOrigin({0.f, 0.f});
         }
     }
-    else if (this->animState == LOOKING_UP) {
-        if (previousState != LOOKING_UP) {
-            this->frame = sf::IntRect({409, 39}, {32, 40});
-            this->sprite.setTextureRect(this->frame);
-        }
-    }
-    else if (this->animState == CURLING_DOWN) {
-        if (previousState != CURLING_DOWN) {
-            float oldBottom = sprite.getPosition().y + sprite.getGlobalBounds().size.y;
-            this->frame = sf::IntRect({491, 47}, {40, 32});
-            this->sprite.setTextureRect(this->frame);
-            float newHeight = sprite.getGlobalBounds().size.y;
-            sprite.setPosition(sf::Vector2f(sprite.getPosition().x, oldBottom - newHeight));
-        }
-    }
 
-    else if (this->animState == PUSHING) {
-        if (previousState != PUSHING) {
-            this->frame = sf::IntRect({388, 404}, {32, 40});
-            this->sprite.setTextureRect(this->frame);
-            this->timer.restart();
-        }
-    }
+    previousAnimState = this->animState;
+}
 
-    else if (this->animState == MOVING_RIGHT || this->animState == MOVING_LEFT) {
-        if (timer.getElapsedTime().asSeconds() >= 0.15f || this->getAnimationSwitch()) {
-            static int frameIndex = 0;
-            switch (frameIndex % 6) {
-                case 0: this->frame = sf::IntRect({30, 131}, {24, 40}); break;
-                case 1: this->frame = sf::IntRect({93, 129}, {40, 40}); break;
-                case 2: this->frame = sf::IntRect({163, 130}, {31, 40}); break;
-                case 3: this->frame = sf::IntRect({233, 131}, {40, 40}); break;
-                case 4: this->frame = sf::IntRect({303, 129}, {40, 40}); break;
-                case 5: this->frame = sf::IntRect({374, 130}, {40, 40}); break;
-            }
-            frameIndex++;
-            this->timer.restart();
-            this->sprite.setTextureRect(this->frame);
-        }
+// Sets the state and shows the first frame of its clip right away, for callers
+// that need the new frame size before the next animation update
+void Player::enterAnimationState(short state) {
+    this->animState = state;
+    if (const AnimationClip* clip = stateClips[state]) {
+        animation.play(*clip, true);
+        this->sprite.setTextureRect(animation.frameRect());
     }
-    else if (this->animState == FULL_SPEED) {
-        if (timer.getElapsedTime().asSeconds() >= 0.1f || this->getAnimationSwitch()) {
-            static int frameIndex = 0;
-            switch (frameIndex % 4) {
-                case 0: this->frame = sf::IntRect({23, 314}, {32, 40}); break;
-                case 1: this->frame = sf::IntRect({93, 314}, {32, 40}); break;
-                case 2: this->frame = sf::IntRect({163, 315}, {32, 39}); break;
-                case 3: this->frame = sf::IntRect({233, 314}, {32, 40}); break;
-            }
-            frameIndex++;
-            this->timer.restart();
-            this->sprite.setTextureRect(this->frame);
-        }
-    }
-    else this->timer.restart();
-
-    previousState = static_cast<PLAYER_ANIMATION_STATES>(this->animState);
 }
 
 
@@ -529,9 +440,7 @@ void Player::updatePhysics() {
         if (isOnGround && !wasOnGround) {
             isJumping = false;
             velocity.y = 0;
-            animState = IDLE;
-            frame = sf::IntRect({27, 39}, {32, 40});
-            sprite.setTextureRect(frame);
+            enterAnimationState(IDLE);
         }
 
         if (!isOnGround) {
@@ -662,8 +571,22 @@ void Player::updatePhysics() {
     sprite.setPosition(pos);
 }
 
+// FALLING and PIPE_SLIDING have no art yet and keep whatever clip was playing
 void Player::initAnimation() {
-    this->timer.restart();
+    const auto& clips = AnimationLibrary::shared();
+    stateClips[IDLE] = &clips.get("sonic_idle");
+    stateClips[BORED] = &clips.get("sonic_bored");
+    stateClips[MOVING_LEFT] = &clips.get("sonic_walk");
+    stateClips[MOVING_RIGHT] = &clips.get("sonic_walk");
+    stateClips[LOOKING_UP] = &clips.get("sonic_look_up");
+    stateClips[CURLING_DOWN] = &clips.get("sonic_curl_down");
+    stateClips[FULL_SPEED] = &clips.get("sonic_full_speed");
+    stateClips[JUMPING] = &clips.get("sonic_jump");
+    stateClips[SKIDDING] = &clips.get("sonic_skid");
+    stateClips[PUSHING] = &clips.get("sonic_push");
+
+    enterAnimationState(IDLE);
+    previousAnimState = IDLE;
     this->animSwitch = true;
 }
 
@@ -675,7 +598,7 @@ bool Player::getAnimationSwitch() {
 
 
 void Player::resetAnimationTimer() {
-    this->timer.restart();
+    this->animation.restart();
     this->animSwitch = true;
 }
 
@@ -701,9 +624,37 @@ sf::Vector2f Player::getPosition() const {
     return this->sprite.getPosition();
 }
 
-void Player::update() {
-    static sf::Clock deltaClock;
-    float deltaTime = deltaClock.restart().asSeconds();
+// Where Sonic is, how he is moving and which flags steer the next step
+void Player::hashState(StateHasher& hasher) const {
+    hasher.add(sprite.getPosition());
+    hasher.add(velocity);
+    hasher.add(groundSpeed);
+    hasher.add(currentMaxSpeed);
+    hasher.add(static_cast<int>(animState));
+    hasher.add(isDead);
+    hasher.add(isHurt);
+    hasher.add(isJumping);
+    hasher.add(isOnGround);
+    hasher.add(jumpButtonHeld);
+    hasher.add(controlLock);
+    hasher.add(isSkidding);
+    hasher.add(isInvincible);
+    hasher.add(hasShield);
+}
+
+void Player::hashTimers(StateHasher& hasher) const {
+    hasher.add(controlLockTimer);
+    hasher.add(airTime);
+    hasher.add(idleTime);
+    hasher.add(hurtTime);
+    hasher.add(invincibilityTimer);
+    hasher.add(speedBoostTimer);
+}
+
+// deltaTime comes from the engine, so a headless engine can step at a fixed rate
+void Player::update(float deltaTime) {
+    idleTime += deltaTime;
+    hurtTime += deltaTime;
 
     if (isDead) {
         return;
@@ -745,24 +696,15 @@ void Player::update() {
 
     if (!isHurt) {
         updateMovement();
-        updateAnimation();
+        updateAnimation(deltaTime);
         updatePhysics();
     }
 
 }
 
 
-void Player::render(sf::RenderWindow &window) const {
-    window.draw(sprite);
-
-
-
-    static sf::Clock coordClock;
-    if (coordClock.getElapsedTime().asSeconds() >= 1.0f) {
-        sf::Vector2f pos = sprite.getPosition();
-
-        coordClock.restart();
-    }
+void Player::render(RenderSnapshot& target) const {
+    target.draw(sprite);
 }
 
 
@@ -852,9 +794,7 @@ void Player::handleDamage() {
 
 
 
-    if (ringLossSound && ringLossSound->getStatus() != sf::Sound::Status::Playing) {
-        ringLossSound->play();
-    }
+    context.play(SoundEffect::RING_LOSS);
 
     if (ringCount > 0) {
         enterHurtState();
@@ -866,9 +806,7 @@ void Player::handleDamage() {
 
 void Player::triggerDeath() {
     if (!isDead) {
-        if (deathSound && deathSound->getStatus() != sf::Sound::Status::Playing) {
-            deathSound->play();
-        }
+        context.play(SoundEffect::DEATH);
 
         isDead = true;
         if (engineRef) {
@@ -894,11 +832,8 @@ void Player::enterHurtState() {
     isHurt = true;
     isInvincible = true;
     hurtTimer = 0.0f;
-    hurtClock.restart();
+    hurtTime = 0.0f;
 
-    if (engineRef) {
-        engineRef->updateRingDisplay();
-    }
 
 
     if (ringsToScatter > 0) {
@@ -945,7 +880,7 @@ void Player::scatterRings(int ringsToScatter) {
         float spawnY = playerPos.y + INNER_RADIUS * std::sin(angle);
 
         float velX = 2.0f * std::cos(angle);
-        float velY = -4.0f + (std::rand() % 2);
+        float velY = -4.0f + context.random->below(2);
 
         engineRef->CreateScatteredRing(
                 sf::Vector2f(spawnX, spawnY),
@@ -961,7 +896,7 @@ void Player::scatterRings(int ringsToScatter) {
         float spawnY = playerPos.y + OUTER_RADIUS * std::sin(angle);
 
         float velX = 3.0f * std::cos(angle);
-        float velY = -5.0f + (std::rand() % 3);
+        float velY = -5.0f + context.random->below(3);
 
         engineRef->CreateScatteredRing(
                 sf::Vector2f(spawnX, spawnY),
@@ -986,9 +921,7 @@ void Player::resetAfterDeath() {
     isSkidding = false;
     ringCount = 0;
 
-    animState = IDLE;
-    frame = sf::IntRect({ 27, 39 }, { 32, 40 });
-    sprite.setTextureRect(frame);
+    enterAnimationState(IDLE);
 
 
     sprite.setScale(sf::Vector2f(1.f, 1.f));
@@ -1000,13 +933,9 @@ void Player::resetAfterDeath() {
     gravityMax = 10.0f;
 
 
-    timer.restart();
-    idleClock.restart();
-    hurtClock.restart();
+    idleTime = 0.0f;
+    hurtTime = 0.0f;
 
-    if (engineRef) {
-        engineRef->updateRingDisplay();
-    }
 
 }
 
@@ -1017,13 +946,12 @@ void Player::updateHurtState() {
         return;
     }
 
-    float elapsedHurtTime = hurtClock.getElapsedTime().asSeconds();
+    float elapsedHurtTime = hurtTime;
 
     if (isHurt) {
         velocity.y = std::min(velocity.y + HURT_GRAVITY, gravityMax);
         updatePhysics();
 
-        static const float HURT_DURATION = 1.0f;
         if (isOnGround || elapsedHurtTime >= HURT_DURATION) {
             velocity.x = 0.0f;
             velocity.y = 0.0f;
@@ -1034,15 +962,12 @@ void Player::updateHurtState() {
     }
 
     if (isInvincible) {
-        static const float INVINCIBILITY_DURATION = 2.0f;
-
         if (elapsedHurtTime >= INVINCIBILITY_DURATION) {
             isInvincible = false;
             sprite.setColor(sf::Color::White);
-            hurtClock.restart();
+            hurtTime = 0.0f;
         } else {
-            static const float FLASH_FREQUENCY = 15.0f;
-            float flashValue = std::abs(std::sin(elapsedHurtTime * FLASH_FREQUENCY));
+            float flashValue = std::abs(std::sin(elapsedHurtTime * HURT_FLASH_FREQUENCY));
             uint8_t alpha = static_cast<uint8_t>(flashValue * 255);
 
             sprite.setColor(sf::Color(255, 100, 100, alpha));
@@ -1069,9 +994,7 @@ void Player::resetGame() {
 
     ringCount = 0;
 
-    animState = IDLE;
-    frame = sf::IntRect({ 27, 39 }, { 32, 40 });
-    sprite.setTextureRect(frame);
+    enterAnimationState(IDLE);
 
     sprite.setScale(sf::Vector2f(1.f, 1.f));
     sprite.setOrigin(sf::Vector2f(0.f, 0.f));
@@ -1080,8 +1003,7 @@ void Player::resetGame() {
     gravity = 0.5f;
     gravityMax = 10.0f;
 
-    timer.restart();
-    idleClock.restart();
-    hurtClock.restart();
+    idleTime = 0.0f;
+    hurtTime = 0.0f;
 
 }
\ No newline at end of file
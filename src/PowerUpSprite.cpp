@@ -1,74 +1,41 @@
 #include "PowerUpSprite.h"
-#include <iostream>
 
-PowerUpSprite::PowerUpSprite(const sf::Vector2f& pos, PowerUpType powerupType)
-        : BaseSprite(pos, true)
+PowerUpSprite::PowerUpSprite(const SpriteArchetypes& types, const sf::Vector2f& pos, PowerUpType powerupType)
+        : BaseSprite(types.get(SpriteKind::POWERUP), pos)
         , type(powerupType)
 {
-    if (!texture.loadFromFile("./assets/misc_fixed.png")) {
-        std::cerr << "fail" << std::endl;
-        return;
-    }
-    texture.setSmooth(false);
-
-    sprite.setTexture(texture);
     initializeFrames();
-    sprite.setTextureRect(frames[0]);
-    sprite.setPosition(position);
-    frameTime = 0.2f;
 }
 
 
+// Picks the box frame and the icon shown on its screen; a broken box has no icon
 void PowerUpSprite::initializeFrames() {
+    const auto& clips = AnimationLibrary::shared();
     if (!broken) {
-
-        frames.emplace_back(sf::IntRect(
-                sf::Vector2i(8, 312),
-                sf::Vector2i(32, 32)
-        ));
-
+        boxFrame = archetype.clip->frames[0].rect;
 
         switch(type) {
             case PowerUpType::RINGS:
-                frames.emplace_back(sf::IntRect(
-                        sf::Vector2i(80, 367),
-                        sf::Vector2i(16, 16)
-                ));
+                iconFrame = clips.get("monitor_icon_rings").frames[0].rect;
                 break;
             case PowerUpType::INVINCIBILITY:
-                frames.emplace_back(sf::IntRect(
-                        sf::Vector2i(56, 391),
-                        sf::Vector2i(16, 16)
-                ));
+                iconFrame = clips.get("monitor_icon_invincibility").frames[0].rect;
                 break;
             case PowerUpType::SPEED:
-                frames.emplace_back(sf::IntRect(
-                        sf::Vector2i(8, 391),
-                        sf::Vector2i(16, 16)
-                ));
+                iconFrame = clips.get("monitor_icon_speed").frames[0].rect;
                 break;
             case PowerUpType::SHIELD:
-                frames.emplace_back(sf::IntRect(
-                        sf::Vector2i(32, 391),
-                        sf::Vector2i(16, 16)
-                ));
+                iconFrame = clips.get("monitor_icon_shield").frames[0].rect;
                 break;
             case PowerUpType::HEALTH:
-                frames.emplace_back(sf::IntRect(
-                        sf::Vector2i(80, 391),
-                        sf::Vector2i(16, 16)
-                ));
+                iconFrame = clips.get("monitor_icon_health").frames[0].rect;
                 break;
         }
     } else {
-
-        frames.clear();
-        frames.emplace_back(sf::IntRect(
-                sf::Vector2i(48, 328),
-                sf::Vector2i(32, 16)
-        ));
-
+        boxFrame = archetype.actionClip->frames[0].rect;
+        iconFrame.reset();
     }
+    sprite.setTextureRect(boxFrame);
 }
 
 
@@ -102,19 +69,19 @@ sf::FloatRect PowerUpSprite::getCollisionBounds() const {
     return sprite.getGlobalBounds();
 }
 
-void PowerUpSprite::render(sf::RenderWindow& window) {
-    sprite.setTextureRect(frames[0]);
-    window.draw(sprite);
+void PowerUpSprite::render(RenderSnapshot& target) {
+    sprite.setTextureRect(boxFrame);
+    target.draw(sprite);
 
-    if (frames.size() > 1) {
+    if (iconFrame) {
         sf::Vector2f originalPos = sprite.getPosition();
         sf::Vector2f iconPos = originalPos;
         iconPos.x += 8;
         iconPos.y += 6;
 
         sprite.setPosition(iconPos);
-        sprite.setTextureRect(frames[1]);
-        window.draw(sprite);
+        sprite.setTextureRect(*iconFrame);
+        target.draw(sprite);
 
         sprite.setPosition(originalPos);
     }
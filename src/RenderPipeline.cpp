@@ -0,0 +1,91 @@
+#include "../include/RenderPipeline.h"
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+RenderPipeline::~RenderPipeline() {
+    stop();
+}
+
+// The window's GL context moves to the render thread; the caller keeps polling
+// events on its own thread
+void RenderPipeline::start(sf::RenderWindow& window, DrawFunction draw) {
+    if (thread.joinable()) return;
+
+    if (!window.setActive(false)) {
+        std::cerr << "fail render thread" << std::endl;
+        return;
+    }
+    stopping = false;
+    error = nullptr;
+    thread = std::thread(&RenderPipeline::renderLoop, this, std::ref(window), std::move(draw));
+}
+
+void RenderPipeline::stop() {
+    if (!thread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    changed.notify_all();
+    thread.join();
+}
+
+// Rethrows on the simulation thread whatever made the render thread give up
+void RenderPipeline::publish() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (thread.joinable()) {
+        changed.wait(lock, [this] { return !fresh || stopping; });
+    }
+    if (error) {
+        std::rethrow_exception(std::exchange(error, nullptr));
+    }
+    std::swap(backIndex, readyIndex);
+    fresh = true;
+    lock.unlock();
+    changed.notify_all();
+}
+
+bool RenderPipeline::acquire() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!fresh) return false;
+        std::swap(frontIndex, readyIndex);
+        fresh = false;
+    }
+    changed.notify_all();
+    return true;
+}
+
+void RenderPipeline::renderLoop(sf::RenderWindow& window, DrawFunction draw) {
+    if (!window.setActive(true)) {
+        std::lock_guard<std::mutex> lock(mutex);
+        error = std::make_exception_ptr(std::runtime_error("fail render thread"));
+        stopping = true;
+        changed.notify_all();
+        return;
+    }
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this] { return fresh || stopping; });
+            if (stopping) break;
+            std::swap(frontIndex, readyIndex);
+            fresh = false;
+        }
+        changed.notify_all();
+
+        try {
+            draw(slots[frontIndex]);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            error = std::current_exception();
+            stopping = true;
+            changed.notify_all();
+            break;
+        }
+    }
+
+    (void)window.setActive(false);
+}
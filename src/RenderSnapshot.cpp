@@ -0,0 +1,104 @@
+#include "../include/RenderSnapshot.h"
+#include <cmath>
+
+// Empties the draw lists but keeps their storage for the next frame
+void RenderSnapshot::clear() {
+    views.resize(1);
+    views[0] = sf::View();
+    vertices.clear();
+    batches.clear();
+}
+
+void RenderSnapshot::setView(const sf::View& view) {
+    if (batches.empty() || batches.back().view != views.size() - 1) {
+        views.back() = view;
+    } else {
+        views.push_back(view);
+    }
+}
+
+// List primitives can be joined with the previous batch; strips and fans cannot
+RenderSnapshot::Batch& RenderSnapshot::batchFor(const sf::Texture* texture, sf::PrimitiveType primitive) {
+    const bool joinable = primitive == sf::PrimitiveType::Triangles || primitive == sf::PrimitiveType::Lines ||
+                          primitive == sf::PrimitiveType::Points;
+    if (joinable && !batches.empty()) {
+        Batch& last = batches.back();
+        if (!last.shared && last.view == views.size() - 1 && last.texture == texture &&
+            last.primitive == primitive) {
+            return last;
+        }
+    }
+    batches.push_back(Batch{views.size() - 1, texture, primitive, vertices.size(), 0, nullptr, sf::Transform()});
+    return batches.back();
+}
+
+// The sprite's quad as two triangles, with its transform already applied
+void RenderSnapshot::draw(const sf::Sprite& sprite) {
+    const sf::FloatRect rect(sprite.getTextureRect());
+    const sf::Vector2f size(std::abs(rect.size.x), std::abs(rect.size.y));
+    const sf::Transform& transform = sprite.getTransform();
+    const sf::Color color = sprite.getColor();
+
+    const float left = rect.position.x;
+    const float right = left + rect.size.x;
+    const float top = rect.position.y;
+    const float bottom = top + rect.size.y;
+
+    const sf::Vertex corners[6] = {
+            {transform.transformPoint({0.f, 0.f}), color, {left, top}},
+            {transform.transformPoint({size.x, 0.f}), color, {right, top}},
+            {transform.transformPoint({0.f, size.y}), color, {left, bottom}},
+            {transform.transformPoint({0.f, size.y}), color, {left, bottom}},
+            {transform.transformPoint({size.x, 0.f}), color, {right, top}},
+            {transform.transformPoint(size), color, {right, bottom}}
+    };
+    draw(corners, 6, sf::PrimitiveType::Triangles, sf::RenderStates(&sprite.getTexture()));
+}
+
+void RenderSnapshot::draw(const sf::VertexArray& source, const sf::RenderStates& states) {
+    if (source.getVertexCount() == 0) return;
+    draw(&source[0], source.getVertexCount(), source.getPrimitiveType(), states);
+}
+
+// Only the texture and transform of states are kept; nothing in the world uses
+// shaders or blend modes
+void RenderSnapshot::draw(const sf::Vertex* source, size_t count, sf::PrimitiveType primitive,
+                          const sf::RenderStates& states) {
+    if (count == 0) return;
+
+    Batch& batch = batchFor(states.texture, primitive);
+    vertices.insert(vertices.end(), source, source + count);
+    for (size_t i = vertices.size() - count; i < vertices.size(); ++i) {
+        vertices[i].position = states.transform.transformPoint(vertices[i].position);
+    }
+    batch.count += count;
+}
+
+// Keeps a handle on an array that is never changed after it is built, so it is
+// drawn as it stands rather than copied vertex by vertex every frame
+void RenderSnapshot::draw(std::shared_ptr<const sf::VertexArray> shared, const sf::RenderStates& states) {
+    if (!shared || shared->getVertexCount() == 0) return;
+
+    const sf::PrimitiveType primitive = shared->getPrimitiveType();
+    batches.push_back(Batch{views.size() - 1, states.texture, primitive, vertices.size(), 0, std::move(shared),
+                            states.transform});
+}
+
+// One draw call per batch, switching views only where the recording did
+void RenderSnapshot::replay(sf::RenderTarget& target) const {
+    size_t currentView = views.size();
+    for (const auto& batch : batches) {
+        if (batch.view != currentView) {
+            currentView = batch.view;
+            target.setView(views[currentView]);
+        }
+        sf::RenderStates states;
+        states.texture = batch.texture;
+        if (batch.shared) {
+            states.transform = batch.transform;
+            target.draw(*batch.shared, states);
+        } else {
+            target.draw(vertices.data() + batch.first, batch.count, batch.primitive, states);
+        }
+    }
+}
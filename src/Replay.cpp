@@ -0,0 +1,141 @@
+#include "../include/Replay.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace {
+    constexpr char INPUT_MAGIC[4] = {'R', 'P', 'L', 'Y'};
+    constexpr char HASH_MAGIC[4] = {'R', 'P', 'L', 'H'};
+    constexpr uint32_t VERSION = 1;
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint64_t seed;
+        uint64_t count;
+    };
+
+    // Buttons and flags of one step, one bit each
+    enum FrameBits : uint8_t {
+        LEFT = 1 << 0,
+        RIGHT = 1 << 1,
+        UP = 1 << 2,
+        DOWN = 1 << 3,
+        JUMP = 1 << 4,
+        RESET = 1 << 5,
+        GOD_MODE = 1 << 6
+    };
+
+    template <typename T>
+    bool readValue(const std::vector<uint8_t>& data, size_t& cursor, T& value) {
+        if (cursor + sizeof(T) > data.size()) return false;
+        std::memcpy(&value, data.data() + cursor, sizeof(T));
+        cursor += sizeof(T);
+        return true;
+    }
+
+    template <typename T>
+    void writeValue(std::vector<uint8_t>& out, const T& value) {
+        const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    Header makeHeader(const char (&magic)[4], uint64_t seed, size_t count) {
+        Header header{};
+        std::memcpy(header.magic, magic, sizeof(header.magic));
+        header.version = VERSION;
+        header.seed = seed;
+        header.count = count;
+        return header;
+    }
+
+    bool readHeader(const std::vector<uint8_t>& data, size_t& cursor, const char (&magic)[4], Header& header) {
+        return readValue(data, cursor, header) && std::memcmp(header.magic, magic, sizeof(magic)) == 0 &&
+               header.version == VERSION;
+    }
+
+    bool writeFile(const std::string& path, const std::vector<uint8_t>& out) {
+        std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+        if (!stream.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()))) {
+            std::cerr << "fail " << path << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    bool readFile(const std::string& path, std::vector<uint8_t>& data) {
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream) return false;
+        data.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        return true;
+    }
+}
+
+// Five bytes a step for the inputs, forty for the hashes
+bool Replay::save(const std::string& path) const {
+    std::vector<uint8_t> out;
+    out.reserve(sizeof(Header) + frames.size() * 5);
+    writeValue(out, makeHeader(INPUT_MAGIC, seed, frames.size()));
+    for (const auto& frame : frames) {
+        uint8_t bits = 0;
+        if (frame.input.left) bits |= LEFT;
+        if (frame.input.right) bits |= RIGHT;
+        if (frame.input.up) bits |= UP;
+        if (frame.input.down) bits |= DOWN;
+        if (frame.input.jump) bits |= JUMP;
+        if (frame.reset) bits |= RESET;
+        if (frame.godMode) bits |= GOD_MODE;
+        writeValue(out, bits);
+        writeValue(out, frame.deltaTime);
+    }
+    if (!writeFile(path, out)) return false;
+
+    out.clear();
+    out.reserve(sizeof(Header) + hashes.size() * sizeof(StateHash));
+    writeValue(out, makeHeader(HASH_MAGIC, seed, hashes.size()));
+    for (const auto& hash : hashes) {
+        writeValue(out, hash.parts);
+    }
+    return writeFile(sidecarPath(path), out);
+}
+
+// A missing sidecar leaves hashes empty; a damaged or mismatched one fails the load
+bool Replay::load(const std::string& path) {
+    frames.clear();
+    hashes.clear();
+
+    std::vector<uint8_t> data;
+    size_t cursor = 0;
+    Header header{};
+    if (!readFile(path, data) || !readHeader(data, cursor, INPUT_MAGIC, header)) return false;
+
+    seed = header.seed;
+    constexpr size_t FRAME_BYTES = sizeof(uint8_t) + sizeof(float);
+    if (header.count > (data.size() - cursor) / FRAME_BYTES) return false;
+    frames.reserve(static_cast<size_t>(header.count));
+    for (uint64_t i = 0; i < header.count; ++i) {
+        uint8_t bits = 0;
+        Frame frame;
+        if (!readValue(data, cursor, bits) || !readValue(data, cursor, frame.deltaTime)) return false;
+        frame.input.left = bits & LEFT;
+        frame.input.right = bits & RIGHT;
+        frame.input.up = bits & UP;
+        frame.input.down = bits & DOWN;
+        frame.input.jump = bits & JUMP;
+        frame.reset = bits & RESET;
+        frame.godMode = bits & GOD_MODE;
+        frames.push_back(frame);
+    }
+
+    cursor = 0;
+    if (!readFile(sidecarPath(path), data)) return true;
+    if (!readHeader(data, cursor, HASH_MAGIC, header) || header.seed != seed) return false;
+
+    if (header.count > (data.size() - cursor) / sizeof(StateHash::parts)) return false;
+    hashes.resize(static_cast<size_t>(header.count));
+    for (auto& hash : hashes) {
+        if (!readValue(data, cursor, hash.parts)) return false;
+    }
+    return true;
+}
@@ -0,0 +1,111 @@
+#include "../include/RingField.h"
+#include <algorithm>
+
+// Comes from the level once it is loaded, so an engine can own a RingField
+// before its sprite sheets are
+void RingField::setArchetype(const SpriteArchetype& type) {
+    archetype = &type;
+    spin.play(*archetype->clip, true);
+}
+
+// Keeps the array sorted by x so collection and culling only look at a window of it.
+// Inserting shifts indices, so the collected bits start over; rings are placed at load time
+void RingField::addRing(const sf::Vector2f& pos) {
+    auto it = std::upper_bound(positions.begin(), positions.end(), pos.x,
+                               [](float x, const sf::Vector2f& ring) { return x < ring.x; });
+    positions.insert(it, pos);
+    collected.assign((positions.size() + 63) / 64, 0);
+}
+
+void RingField::addRingGroup(float startX, float startY, int count) {
+    for (int i = 0; i < count; ++i) {
+        addRing(sf::Vector2f(startX + i * GROUP_SPACING, startY));
+    }
+}
+
+void RingField::clear() {
+    positions.clear();
+    collected.clear();
+}
+
+void RingField::setCollected(size_t index) {
+    collected[index / 64] |= uint64_t{1} << (index % 64);
+}
+
+// Collects every ring touching bounds and returns how many were picked up
+int RingField::collect(const sf::FloatRect& bounds, const EngineContext& context) {
+    if (!archetype) return 0;
+    const sf::Vector2f ringSize(spin.frameRect().size);
+    const float left = bounds.position.x - ringSize.x;
+    const float right = bounds.position.x + bounds.size.x;
+
+    auto first = std::lower_bound(positions.begin(), positions.end(), left,
+                                  [](const sf::Vector2f& ring, float x) { return ring.x < x; });
+
+    int count = 0;
+    for (auto it = first; it != positions.end() && it->x <= right; ++it) {
+        size_t index = static_cast<size_t>(it - positions.begin());
+        if (isCollected(index)) continue;
+
+        if (bounds.findIntersection(sf::FloatRect(*it, ringSize))) {
+            setCollected(index);
+            if (particles) {
+                particles->emit(ParticleEffect::RING_SPARKLE, *it + ringSize / 2.0f);
+            }
+            ++count;
+        }
+    }
+
+    if (count > 0) {
+        context.play(archetype->sound);
+    }
+    return count;
+}
+
+void RingField::reset() {
+    std::fill(collected.begin(), collected.end(), 0);
+    spin.restart();
+}
+
+// One clip step for the whole field
+void RingField::update(float deltaTime) {
+    spin.advance(deltaTime);
+}
+
+void RingField::appendQuad(const sf::Vector2f& pos, const sf::IntRect& rect) {
+    const sf::Vector2f size(rect.size);
+    const sf::Vector2f tex(rect.position);
+    const sf::Vector2f corners[6] = {
+            {0.f, 0.f}, {size.x, 0.f}, {0.f, size.y},
+            {0.f, size.y}, {size.x, 0.f}, {size.x, size.y}
+    };
+    for (const auto& corner : corners) {
+        vertices.append(sf::Vertex{pos + corner, sf::Color::White, tex + corner});
+    }
+}
+
+// Rebuilds the quads of the rings inside the current view and draws them in one call
+void RingField::render(RenderSnapshot& target) {
+    if (!archetype) return;
+
+    const sf::View& view = target.getView();
+    const sf::FloatRect visible(view.getCenter() - view.getSize() / 2.0f, view.getSize());
+    const sf::IntRect& frame = spin.frameRect();
+
+    vertices.clear();
+
+    auto first = std::lower_bound(positions.begin(), positions.end(), visible.position.x - frame.size.x,
+                                  [](const sf::Vector2f& ring, float x) { return ring.x < x; });
+    for (auto it = first; it != positions.end() && it->x <= visible.position.x + visible.size.x; ++it) {
+        size_t index = static_cast<size_t>(it - positions.begin());
+        if (isCollected(index)) continue;
+        if (it->y + frame.size.y < visible.position.y || it->y > visible.position.y + visible.size.y) continue;
+        appendQuad(*it, frame);
+    }
+
+    if (vertices.getVertexCount() > 0) {
+        sf::RenderStates states;
+        states.texture = archetype->texture;
+        target.draw(vertices, states);
+    }
+}
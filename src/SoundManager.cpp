@@ -1,37 +1,146 @@
 #include "SoundManager.h"
+#include "AssetPack.h"
 #include <iostream>
 
-SoundManager* SoundManager::instance = nullptr;
+SoundManager::SoundManager() {
+    mixer.setVolume(volume);
+    mixer.play();
+}
+
+// Decodes a file straight into the mixer's format. Touches no shared state, so
+// the asset loader runs it on its worker threads
+PcmClip SoundManager::decode(const std::string& filepath) {
+    sf::InputSoundFile file;
+    if (!AssetPack::load(filepath, file)) {
+        return PcmClip();
+    }
+    return decode(file);
+}
 
-SoundManager& SoundManager::getInstance() {
-    if (!instance) {
-        instance = new SoundManager();
+// The same from an encoded file already in memory
+PcmClip SoundManager::decode(const void* data, size_t size) {
+    sf::InputSoundFile file;
+    if (!file.openFromMemory(data, size)) {
+        return PcmClip();
     }
-    return *instance;
+    return decode(file);
 }
 
-void SoundManager::loadSound(const std::string& name, const std::string& filepath) {
+PcmClip SoundManager::decode(sf::InputSoundFile& file) {
+    std::vector<int16_t> samples(static_cast<size_t>(file.getSampleCount()));
+    const uint64_t read = file.read(samples.data(), samples.size());
+    return AudioMixer::convert(samples.data(), read, file.getChannelCount(), file.getSampleRate());
+}
 
-    if (buffers.find(name) == buffers.end()) {
-        auto buffer = std::make_unique<sf::SoundBuffer>();
-        if (buffer->loadFromFile(filepath)) {
-            buffers[name] = std::move(buffer);
-            sounds[name] = std::make_unique<sf::Sound>(*buffers[name]);
+// Uses the cached decode when the source is unchanged, otherwise decodes now and
+// queues the result for the cache. Loading a name again returns its id and
+// updates its priority and cooldown
+SoundId SoundManager::loadSound(const std::string& name, const std::string& filepath, int priority, float cooldown) {
+    SoundId id = loadCached(name, filepath);
+    if (id == NO_SOUND) {
+        id = addSound(name, filepath, decode(filepath));
+    }
+    if (id == NO_SOUND) {
+        return NO_SOUND;
+    }
 
-            sounds[name]->setVolume(volume);
-        } else {
-            std::cerr << "fail " << filepath << std::endl;
-        }
+    auto& entry = *entries[static_cast<size_t>(id)];
+    entry.clip.priority = priority;
+    entry.cooldown = cooldown;
+    return id;
+}
+
+// Registers the sound only if the PCM cache already holds it
+SoundId SoundManager::loadCached(const std::string& name, const std::string& filepath) {
+    SoundId id = find(name);
+    if (id != NO_SOUND) {
+        return id;
+    }
+
+    PcmClip clip;
+    AssetPack::Blob blob;
+    const bool cached = AssetPack::lookup(filepath, blob)
+                        ? cache.find(filepath, blob.size, blob.checksum, clip.samples, clip.length)
+                        : cache.find(filepath, clip.samples, clip.length);
+    if (!cached) {
+        return NO_SOUND;
     }
+    return addEntry(name, filepath, std::move(clip));
 }
 
-void SoundManager::playSound(const std::string& name) {
-    auto it = sounds.find(name);
-    if (it != sounds.end()) {
+// Registers samples decoded elsewhere and remembers them for the next cache save
+SoundId SoundManager::addSound(const std::string& name, const std::string& filepath, PcmClip&& clip) {
+    SoundId id = find(name);
+    if (id != NO_SOUND) {
+        return id;
+    }
+    if (clip.empty()) {
+        std::cerr << "fail " << filepath << std::endl;
+        return NO_SOUND;
+    }
 
-        it->second->setVolume(volume);
-        it->second->play();
+    id = addEntry(name, filepath, std::move(clip));
+    const auto& stored = entries[static_cast<size_t>(id)]->clip;
+    AssetPack::Blob blob;
+    if (AssetPack::lookup(filepath, blob)) {
+        cache.store(filepath, blob.size, blob.checksum, stored.samples, stored.length);
     } else {
-        std::cerr << "fail " << name << std::endl;
+        cache.store(filepath, stored.samples, stored.length);
     }
-}
\ No newline at end of file
+    return id;
+}
+
+SoundId SoundManager::addEntry(const std::string& name, const std::string& source, PcmClip&& clip) {
+    auto entry = std::make_unique<SoundEntry>();
+    entry->name = name;
+    entry->source = source;
+    entry->clip = std::move(clip);
+
+    const SoundId id = static_cast<SoundId>(entries.size());
+    entries.push_back(std::move(entry));
+    ids[name] = id;
+    return id;
+}
+
+// The cache lets go of its mapping while the new file is swapped in, so every
+// clip read from it is silenced first and pointed into the new mapping after.
+// A failed save keeps the cache dirty, so the next call tries again
+bool SoundManager::saveCache() {
+    if (!cache.isDirty()) return true;
+
+    mixer.stopAll();
+    const bool saved = cache.save();
+    for (auto& entry : entries) {
+        PcmClip& clip = entry->clip;
+        if (!clip.storage.empty()) continue;
+        if (!cache.lookup(entry->source, clip.samples, clip.length)) {
+            clip.samples = nullptr;
+            clip.length = 0;
+        }
+    }
+    if (!saved) {
+        std::cerr << "fail sound cache not saved, sounds decode again next start" << std::endl;
+    }
+    return saved;
+}
+
+SoundId SoundManager::find(const std::string& name) const {
+    auto it = ids.find(name);
+    return it != ids.end() ? it->second : NO_SOUND;
+}
+
+// Repeats inside a sound's cooldown are dropped, so a burst of pickups is one chime
+void SoundManager::playSound(SoundId id) {
+    if (id < 0 || id >= static_cast<SoundId>(entries.size())) {
+        return;
+    }
+
+    auto& entry = *entries[static_cast<size_t>(id)];
+    const float now = clock.getElapsedTime().asSeconds();
+    if (entry.lastPlayed >= 0.0f && now - entry.lastPlayed < entry.cooldown) {
+        return;
+    }
+    entry.lastPlayed = now;
+    mixer.trigger(entry.clip);
+    if (playCounter) playCounter->add();
+}
@@ -1,30 +1,13 @@
 #include "../include/SpikeSprite.h"
-#include <iostream>
 
-SpikeSprite::SpikeSprite(const sf::Vector2f& pos)
-        : BaseSprite(pos, false)
+SpikeSprite::SpikeSprite(const SpriteArchetypes& types, const sf::Vector2f& pos)
+        : BaseSprite(types.get(SpriteKind::SPIKE), pos)
 {
-    if (!texture.loadFromFile("./assets/misc_fixed.png")) {
-        std::cerr << "Fail" << std::endl;
-        return;
-    }
-
-    sprite.setTexture(texture);
-    initializeFrames();
-    sprite.setTextureRect(frames[0]);
-    sprite.setPosition(position);
-}
-
-void SpikeSprite::initializeFrames() {
-    frames.emplace_back(sf::IntRect(
-            sf::Vector2i(308, 25),
-            sf::Vector2i(40, 32)
-    ));
 }
 
 sf::FloatRect SpikeSprite::getCollisionBounds() const {
     auto bounds = sprite.getGlobalBounds();
-    float reduction = 4.0f;
+    float reduction = archetype.hitboxInset;
 
 
     sf::Vector2f position(
@@ -42,8 +25,8 @@ sf::FloatRect SpikeSprite::getCollisionBounds() const {
 
 
 
-void SpikeSprite::createSpikeGroup(std::vector<SpikeSprite*>& sprites, const std::vector<sf::Vector2f>& positions) {
+void SpikeSprite::createSpikeGroup(std::vector<SpikeSprite*>& sprites, const std::vector<sf::Vector2f>& positions, const SpriteArchetypes& types) {
     for (const auto& pos : positions) {
-        sprites.push_back(new SpikeSprite(pos));
+        sprites.push_back(new SpikeSprite(types, pos));
     }
 }
\ No newline at end of file
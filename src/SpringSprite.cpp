@@ -1,22 +1,8 @@
 #include "SpringSprite.h"
-#include <iostream>
 
-SpringSprite::SpringSprite(const sf::Vector2f& pos) : BaseSprite(pos, false) {
-    if (!texture.loadFromFile("./assets/misc_fixed.png")) {
-        std::cerr << "fail" << std::endl;
-        return;
-    }
-
-    initializeFrames();
-    sprite.setTextureRect(m_normalFrame);
-    sprite.setPosition(position);
-}
-
-void SpringSprite::initializeFrames() {
-
-    m_normalFrame = sf::IntRect(NORMAL_FRAME_POS, NORMAL_FRAME_SIZE);
-
-    m_extendedFrame = sf::IntRect(EXTENDED_FRAME_POS, EXTENDED_FRAME_SIZE);
+SpringSprite::SpringSprite(const SpriteArchetypes& types, const sf::Vector2f& pos)
+        : BaseSprite(types.get(SpriteKind::SPRING), pos) {
+    sprite.setTextureRect(NORMAL_FRAME);
 }
 
 void SpringSprite::extend() {
@@ -28,7 +14,7 @@ void SpringSprite::extend() {
 
         float heightDiff = static_cast<float>(EXTENDED_FRAME_SIZE.y - NORMAL_FRAME_SIZE.y);
         sprite.setPosition(sf::Vector2f(position.x, position.y - heightDiff));
-        sprite.setTextureRect(m_extendedFrame);
+        sprite.setTextureRect(EXTENDED_FRAME);
     }
 }
 
@@ -40,14 +26,14 @@ void SpringSprite::update(float deltaTime) {
             m_extended = false;
             m_canBounce = true;
             sprite.setPosition(position);
-            sprite.setTextureRect(m_normalFrame);
+            sprite.setTextureRect(NORMAL_FRAME);
         }
     }
 }
 
 void SpringSprite::createSpringGroup(std::vector<SpringSprite*>& springs,
-                                     const std::vector<sf::Vector2f>& positions) {
+                                     const std::vector<sf::Vector2f>& positions, const SpriteArchetypes& types) {
     for (const auto& pos : positions) {
-        springs.push_back(new SpringSprite(pos));
+        springs.push_back(new SpringSprite(types, pos));
     }
 }
\ No newline at end of file
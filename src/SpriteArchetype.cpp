@@ -0,0 +1,107 @@
+#include "../include/SpriteArchetype.h"
+#include "../include/AssetLoader.h"
+#include <stdexcept>
+#include <string>
+
+namespace {
+    const sf::Texture* sheetOf(const AssetLoader& assets, const std::string& path) {
+        const sf::Texture* sheet = assets.texture(path);
+        if (!sheet) {
+            throw std::runtime_error("fail " + path);
+        }
+        return sheet;
+    }
+}
+
+// Every sheet comes from the level's loader, which LevelData keeps alive as long
+// as these archetypes
+void SpriteArchetypes::resolve(const AssetLoader& assets) {
+    const auto& clips = AnimationLibrary::shared();
+    const sf::Texture* misc = sheetOf(assets, "./assets/misc_fixed.png");
+    const sf::Texture* enemies = sheetOf(assets, "./assets/enemies_sheet_fixed.png");
+    const sf::Texture* animals = sheetOf(assets, "./assets/animals_fixed.png");
+    const sf::Texture* flowers = sheetOf(assets, "./assets/flowers.png");
+    const sf::IntRect projectile = clips.get("enemy_projectile").frames[0].rect;
+
+    auto& ring = at(SpriteKind::RING);
+    ring.texture = misc;
+    ring.clip = &clips.get("ring_spin");
+    ring.actionClip = &clips.get("ring_collect");
+    ring.sound = SoundEffect::RING_COLLECT;
+    ring.animated = true;
+
+    auto& checkpoint = at(SpriteKind::CHECKPOINT);
+    checkpoint.texture = misc;
+    checkpoint.clip = &clips.get("checkpoint_spin");
+    checkpoint.animated = true;
+
+    auto& spike = at(SpriteKind::SPIKE);
+    spike.texture = misc;
+    spike.clip = &clips.get("spike");
+    spike.hitboxInset = 4.0f;
+
+    auto& bridge = at(SpriteKind::BRIDGE);
+    bridge.texture = misc;
+    bridge.clip = &clips.get("bridge");
+
+    auto& platform = at(SpriteKind::PLATFORM);
+    platform.texture = misc;
+    platform.clip = &clips.get("platform");
+
+    at(SpriteKind::SPRING).texture = misc;
+
+    auto& powerUp = at(SpriteKind::POWERUP);
+    powerUp.texture = misc;
+    powerUp.clip = &clips.get("monitor");
+    powerUp.actionClip = &clips.get("monitor_broken");
+
+    auto& animal = at(SpriteKind::ANIMAL);
+    animal.texture = animals;
+    animal.clip = &clips.get("animal");
+    animal.animated = true;
+
+    auto& buzzer = at(SpriteKind::BUZZER);
+    buzzer.texture = enemies;
+    buzzer.clip = &clips.get("buzzer_fly");
+    buzzer.actionClip = &clips.get("buzzer_shoot");
+    buzzer.projectileFrame = projectile;
+    buzzer.sound = SoundEffect::BADNIK_DEATH;
+    buzzer.animated = true;
+
+    auto& motobug = at(SpriteKind::MOTOBUG);
+    motobug.texture = enemies;
+    motobug.clip = &clips.get("motobug_drive");
+    motobug.actionClip = &clips.get("motobug_smoke");
+    motobug.sound = SoundEffect::BADNIK_DEATH;
+    motobug.animated = true;
+
+    auto& crabmeat = at(SpriteKind::CRABMEAT);
+    crabmeat.texture = enemies;
+    crabmeat.clip = &clips.get("crabmeat_walk");
+    crabmeat.actionClip = &clips.get("crabmeat_attack");
+    crabmeat.projectileFrame = projectile;
+    crabmeat.sound = SoundEffect::BADNIK_DEATH;
+    crabmeat.animated = true;
+
+    auto& fish = at(SpriteKind::FISH);
+    fish.texture = enemies;
+    fish.clip = &clips.get("fish_swim");
+    fish.sound = SoundEffect::BADNIK_DEATH;
+    fish.animated = true;
+
+    auto& tallFlower = at(SpriteKind::FLOWER_TALL);
+    tallFlower.texture = flowers;
+    tallFlower.clip = &clips.get("flower_tall");
+    tallFlower.animated = true;
+
+    auto& shortFlower = at(SpriteKind::FLOWER_SHORT);
+    shortFlower.texture = flowers;
+    shortFlower.clip = &clips.get("flower_short");
+    shortFlower.animated = true;
+}
+
+SpriteArchetype& SpriteArchetypes::at(SpriteKind kind) {
+    auto& type = types[static_cast<size_t>(kind)];
+    type.kind = kind;
+    return type;
+}
@@ -0,0 +1,83 @@
+#include "../include/StartupTimeline.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+    const char* kindName(StartupTimeline::Kind kind) {
+        switch (kind) {
+            case StartupTimeline::Kind::CPU: return "cpu";
+            case StartupTimeline::Kind::IO: return "io";
+            case StartupTimeline::Kind::DECODE: return "decode";
+            case StartupTimeline::Kind::UPLOAD: return "upload";
+            case StartupTimeline::Kind::MARK: return "mark";
+        }
+        return "?";
+    }
+}
+
+StartupTimeline::Scope::Scope(StartupTimeline* timeline, const char* name) : timeline(timeline) {
+    if (!timeline) return;
+    index = timeline->spans.size();
+    timeline->spans.push_back(Span{name, Kind::CPU, timeline->depth, timeline->now(), 0.0, 0});
+    ++timeline->depth;
+}
+
+StartupTimeline::Scope::~Scope() {
+    if (!timeline) return;
+    --timeline->depth;
+    Span& span = timeline->spans[index];
+    span.durationMs = timeline->now() - span.startMs;
+}
+
+void StartupTimeline::add(const std::string& name, Kind kind, double startMs, double durationMs, size_t bytes) {
+    spans.push_back(Span{name, kind, depth, startMs, durationMs, bytes});
+}
+
+void StartupTimeline::mark(const std::string& name) {
+    if (getMark(name) >= 0.0) return;
+    add(name, Kind::MARK, now(), 0.0);
+}
+
+double StartupTimeline::getMark(const std::string& name) const {
+    for (const auto& span : spans) {
+        if (span.kind == Kind::MARK && span.name == name) return span.startMs;
+    }
+    return -1.0;
+}
+
+// Worker spans are added when the main thread gets to them, so the list is put
+// back in start order; a stable sort keeps each scope ahead of its children
+void StartupTimeline::report(std::ostream& out) const {
+    std::vector<const Span*> ordered;
+    for (const auto& span : spans) ordered.push_back(&span);
+    std::stable_sort(ordered.begin(), ordered.end(),
+                     [](const Span* a, const Span* b) { return a->startMs < b->startMs; });
+
+    char line[256];
+    double totals[5] = {};
+    size_t bytes[5] = {};
+    out << "   start ms     dur ms  kind      bytes  name\n";
+    for (const Span* span : ordered) {
+        const int kind = static_cast<int>(span->kind);
+        if (span->kind != Kind::CPU || span->depth == 0) {
+            totals[kind] += span->durationMs;
+            bytes[kind] += span->bytes;
+        }
+        std::snprintf(line, sizeof(line), "%11.2f %10.2f  %-6s %10zu  %*s%s\n", span->startMs, span->durationMs,
+                      kindName(span->kind), span->bytes, span->depth * 2, "", span->name.c_str());
+        out << line;
+    }
+
+    // Worker times add up across threads, so they can exceed the wall time
+    out << "totals:\n";
+    for (int kind = 0; kind < static_cast<int>(Kind::MARK); ++kind) {
+        std::snprintf(line, sizeof(line), "  %-6s %10.2f ms %12zu bytes\n",
+                      kindName(static_cast<Kind>(kind)), totals[kind], bytes[kind]);
+        out << line;
+    }
+    for (const Span* span : ordered) {
+        if (span->kind != Kind::MARK) continue;
+        std::snprintf(line, sizeof(line), "%s_ms %.2f\n", span->name.c_str(), span->startMs);
+        out << line;
+    }
+}
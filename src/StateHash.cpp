@@ -0,0 +1,26 @@
+#include "../include/StateHash.h"
+
+const char* hashPartName(HashPart part) {
+    switch (part) {
+        case HashPart::PLAYER: return "player";
+        case HashPart::BADNIKS: return "badniks";
+        case HashPart::RINGS: return "rings";
+        case HashPart::RANDOM: return "random";
+        case HashPart::TIMERS: return "timers";
+        default: return "unknown";
+    }
+}
+
+void StateHasher::add(const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+}
+
+uint64_t StateHash::combined() const {
+    StateHasher hasher;
+    hasher.add(parts.data(), sizeof(parts));
+    return hasher.value();
+}
@@ -0,0 +1,74 @@
+#include "../include/WorldRenderTarget.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+WorldRenderTarget::WorldRenderTarget(const sf::Vector2u& nativeSize)
+        : nativeSize(nativeSize)
+{
+}
+
+// Resizes the texture only when the wanted size actually changes
+bool WorldRenderTarget::ensureSize(const sf::Vector2u& size) {
+    if (texture.getSize() == size) {
+        return true;
+    }
+    if (!texture.resize(size)) {
+        std::cerr << "fail world render target " << size.x << "x" << size.y << std::endl;
+        failed = true;
+        return false;
+    }
+    return true;
+}
+
+// Returns where the world should be drawn this frame: the offscreen texture when
+// it is needed, otherwise (or if the texture could not be created) the screen itself
+sf::RenderTarget& WorldRenderTarget::begin(sf::RenderTarget& screen) {
+    active = false;
+    if (failed || (!pixelPerfect && renderScale >= 1.0f)) {
+        return screen;
+    }
+
+    sf::Vector2u size = nativeSize;
+    if (!pixelPerfect) {
+        size = sf::Vector2u(
+                std::max(1u, static_cast<unsigned>(std::lround(screen.getSize().x * renderScale))),
+                std::max(1u, static_cast<unsigned>(std::lround(screen.getSize().y * renderScale)))
+        );
+    }
+    if (!ensureSize(size)) {
+        return screen;
+    }
+
+    texture.setSmooth(!pixelPerfect);
+    texture.clear();
+    active = true;
+    return texture;
+}
+
+void WorldRenderTarget::present(sf::RenderTarget& screen) {
+    if (!active) return;
+
+    texture.display();
+
+    const sf::Vector2u screenSize = screen.getSize();
+    const sf::Vector2u textureSize = texture.getSize();
+    sf::Sprite frame(texture.getTexture());
+
+    if (pixelPerfect) {
+        const unsigned scale = std::max(1u, std::min(screenSize.x / textureSize.x, screenSize.y / textureSize.y));
+        frame.setScale(sf::Vector2f(static_cast<float>(scale), static_cast<float>(scale)));
+        frame.setPosition(sf::Vector2f(
+                static_cast<float>((static_cast<int>(screenSize.x) - static_cast<int>(textureSize.x * scale)) / 2),
+                static_cast<float>((static_cast<int>(screenSize.y) - static_cast<int>(textureSize.y * scale)) / 2)
+        ));
+    } else {
+        frame.setScale(sf::Vector2f(
+                static_cast<float>(screenSize.x) / textureSize.x,
+                static_cast<float>(screenSize.y) / textureSize.y
+        ));
+    }
+
+    screen.setView(screen.getDefaultView());
+    screen.draw(frame);
+}
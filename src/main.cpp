@@ -1,19 +1,127 @@
+#include <cstdlib>
 #include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include "../include/FlightRecorder.h"
 #include "../include/GameEngine.h"
+#include "../include/MetricsExporter.h"
+#include "../include/StartupTimeline.h"
+
+namespace {
+    // Plays a recorded run on a headless engine and reports the first step whose
+    // state hash differs from the recording's sidecar
+    int verifyReplay(const std::string& path) {
+        Replay replay;
+        if (!replay.load(path)) {
+            std::cerr << "fail " << path << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (replay.hashes.empty()) {
+            std::cerr << "fail " << Replay::sidecarPath(path) << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        AssetPack pack;
+        int result = EXIT_SUCCESS;
+        {
+            GameEngine engine(GameEngine::loadHeadlessLevel(pack));
+            const auto divergence = engine.playReplay(replay);
+            if (divergence) {
+                std::cout << "diverged at frame " << divergence->frame << " in "
+                          << hashPartName(divergence->part) << std::endl;
+                result = EXIT_FAILURE;
+            } else {
+                std::cout << "matched " << replay.frames.size() << " frames" << std::endl;
+            }
+        }
+        AssetPack::unmount(&pack);
+        return result;
+    }
+}
+
+// --record <file> saves the run's inputs and per-step state hashes on exit;
+// --verify <file> replays such a recording headless and checks it.
+// --metrics-file <file> rewrites the engine's metrics there every few seconds;
+// --metrics-port <port> serves them to scrapers on localhost.
+// --bench-startup exits after the first frame drawn with the level built and
+// prints the startup timeline, ending in the time to each first frame
+int main(int argc, char* argv[]) {
+    StartupTimeline timeline;   // first, so it times everything after process start
+
+    std::string recordPath;
+    std::string verifyPath;
+    std::string metricsPath;
+    unsigned short metricsPort = 0;
+    bool benchStartup = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--bench-startup") {
+            benchStartup = true;
+        } else if (i + 1 >= argc) {
+            break;
+        } else if (arg == "--record") {
+            recordPath = argv[++i];
+        } else if (arg == "--verify") {
+            verifyPath = argv[++i];
+        } else if (arg == "--metrics-file") {
+            metricsPath = argv[++i];
+        } else if (arg == "--metrics-port") {
+            metricsPort = static_cast<unsigned short>(std::strtoul(argv[++i], nullptr, 10));
+        }
+    }
+
+    // Outlives the engine, so the catch below still has the frames before a crash
+    FlightRecorder flightRecorder;
 
-int main() {
     try {
-        auto gameEngine = GameEngine();
+        if (!verifyPath.empty()) {
+            return verifyReplay(verifyPath);
+        }
+
+        std::optional<StartupTimeline::Scope> constructing(std::in_place, &timeline, "GameEngine()");
+        auto gameEngine = GameEngine(&timeline);
+        constructing.reset();
+        if (!recordPath.empty()) {
+            gameEngine.startRecording();
+        }
+
+        gameEngine.setFlightRecorder(&flightRecorder);
+
+        MetricsExporter exporter(gameEngine.getMetrics());
+        if (!metricsPath.empty() || metricsPort != 0) {
+            exporter.start(metricsPath, metricsPort);
+        }
+
+        // Drawing gets its own thread when there are cores to spare for it. The
+        // startup bench draws on this one, so a frame is done when render() returns
+        gameEngine.setPipelined(!benchStartup && std::thread::hardware_concurrency() >= 4);
 
         while (gameEngine.running()) {
             gameEngine.update();
-            gameEngine.render();
+            if (!gameEngine.isPipelined()) {
+                gameEngine.render();
+            }
+
+            if (benchStartup) {
+                timeline.mark("first_frame");
+                if (gameEngine.isLevelLoaded()) {
+                    timeline.mark("first_level_frame");
+                    timeline.report(std::cout);
+                    gameEngine.close();
+                }
+            }
+        }
+
+        if (!recordPath.empty() && !gameEngine.getRecording()->save(recordPath)) {
+            return EXIT_FAILURE;
         }
     }
     catch (const std::exception& e) {
         std::cerr << "error: " << e.what() << std::endl;
+        flightRecorder.dump(std::string("exception: ") + e.what());
         return EXIT_FAILURE;
     }
 
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
@@ -0,0 +1,171 @@
+// Headless checks on the simulation, run by ctest from the source tree so the
+// loose assets are found:
+//
+//   replay_checks
+//
+// Each check prints "fail <check>: <why>" on a mismatch; the exit code is the
+// number of checks that failed
+#include "../include/GameEngine.h"
+#include "../include/Player.h"
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr uint64_t SEED = 454;
+    constexpr float STEP = 1.0f / 60.0f;
+    constexpr size_t MAX_STEPS = 3000;
+    constexpr size_t SETTLE_STEPS = 30;         // steps taken after the monitor breaks
+    constexpr float REACH = 3.0f;               // god mode moves 5px a step
+    constexpr float CRUISE_Y = 399.0f;          // above the badniks walking the ground
+    constexpr float SPRING_DROP = 50.0f;        // above the spring, where god mode is turned off
+
+    bool fail(const std::string& check, const std::string& why) {
+        std::cerr << "fail " << check << ": " << why << std::endl;
+        return false;
+    }
+
+    // One god mode step towards target; true once the player is there
+    bool flyTo(GameEngine& engine, const sf::Vector2f& target, Replay::Frame& frame) {
+        const sf::Vector2f pos = engine.GetPlayer()->getPosition();
+        frame = Replay::Frame{PlayerInput{}, STEP, false, true};
+        frame.input.left = pos.x > target.x + REACH;
+        frame.input.right = pos.x < target.x - REACH;
+        frame.input.up = pos.y > target.y + REACH;
+        frame.input.down = pos.y < target.y - REACH;
+        return !frame.input.left && !frame.input.right && !frame.input.up && !frame.input.down;
+    }
+
+    // God mode moves along the route and never rolls, but keeps the ball it
+    // was in when it was turned on. So the player flies to the first spring,
+    // drops onto it for a rolling bounce, turns god mode back on, rolls through
+    // the buzzer that would shoot it down and flies into the shield monitor
+    // from above, then keeps going for a few steps with the shield. Returns
+    // the steps taken, with the state hash after each. With a snapshot, a
+    // frame is recorded after every step as the windowed loop does
+    Replay breakShieldMonitor(GameEngine& engine, const LevelData& level, RenderSnapshot* snapshot = nullptr) {
+        sf::Vector2f monitor;
+        for (const auto& spawn : level.powerUps) {
+            if (spawn.type == PowerUpSprite::PowerUpType::SHIELD) monitor = spawn.position;
+        }
+        const sf::Vector2f spring = level.springs.front();
+        const sf::Vector2f start = engine.GetPlayer()->getPosition();
+        const std::vector<sf::Vector2f> toSpring{{start.x, CRUISE_Y},
+                                                 {spring.x + 1.0f, CRUISE_Y},
+                                                 {spring.x + 1.0f, spring.y - SPRING_DROP}};
+        sf::Vector2f buzzer = level.buzzers.front();
+        for (const auto& pos : level.buzzers) {
+            if (std::abs(pos.x - monitor.x) < std::abs(buzzer.x - monitor.x)) buzzer = pos;
+        }
+        const std::vector<sf::Vector2f> toMonitor{{spring.x + 1.0f, CRUISE_Y},
+                                                  {buzzer.x, CRUISE_Y},
+                                                  buzzer,
+                                                  {monitor.x + 12.0f, buzzer.y},
+                                                  {monitor.x + 12.0f, monitor.y + 20.0f}};
+
+        Replay run;
+        run.seed = SEED;
+        size_t next = 0;
+        bool bounced = false;
+        size_t shielded = 0;
+        while (run.frames.size() < MAX_STEPS && shielded < SETTLE_STEPS) {
+            Replay::Frame frame{PlayerInput{}, STEP, false, false};
+            const std::vector<sf::Vector2f>& route = bounced ? toMonitor : toSpring;
+            if (next < route.size()) {
+                if (flyTo(engine, route[next], frame)) ++next;
+            } else if (!bounced) {
+                frame.input.jump = true;
+                if (engine.GetPlayer()->velocity.y < -15.0f) {
+                    bounced = true;
+                    next = 0;
+                }
+            }
+            engine.stepReplay(frame);
+            run.frames.push_back(frame);
+            run.hashes.push_back(engine.hashState());
+            if (snapshot) engine.recordFrame(*snapshot);
+            if (engine.GetPlayer()->HasShield()) ++shielded;
+        }
+        return run;
+    }
+
+    // A windowed engine records a snapshot after every step; a headless one
+    // never does. Recording must not change the run, so both hash the same
+    // step for step, through a monitor break
+    bool windowedMatchesHeadless(const std::shared_ptr<const LevelData>& level) {
+        const std::string check = "windowed_matches_headless";
+
+        GameEngine headless(level);
+        headless.setSeed(SEED);
+        const Replay run = breakShieldMonitor(headless, *level);
+        if (!headless.GetPlayer()->HasShield()) return fail(check, "the shield monitor was never broken");
+
+        GameEngine windowed(level);
+        windowed.setSeed(run.seed);
+        RenderSnapshot snapshot;
+        for (size_t i = 0; i < run.frames.size(); ++i) {
+            windowed.stepReplay(run.frames[i]);
+            const uint64_t stepped = windowed.hashState().combined();
+            if (stepped != run.hashes[i].combined()) {
+                return fail(check, "diverged at step " + std::to_string(i));
+            }
+            windowed.recordFrame(snapshot);
+            if (windowed.hashState().combined() != stepped) {
+                return fail(check, "recording a frame changed the state at step " + std::to_string(i));
+            }
+        }
+        if (!windowed.GetPlayer()->HasShield()) return fail(check, "the windowed run kept the monitor");
+        return true;
+    }
+
+    // What `main --record` and `main --verify` do: a run recorded on an engine
+    // that records frames, saved with its hash sidecar, loaded back and played
+    // on a fresh headless engine, which has to match it step for step
+    bool recordingVerifies(const std::shared_ptr<const LevelData>& level) {
+        const std::string check = "recording_verifies";
+        const std::string path = (std::filesystem::temp_directory_path() / "replay_checks.rpl").string();
+
+        GameEngine recorder(level);
+        recorder.startRecording();
+        RenderSnapshot snapshot;
+        breakShieldMonitor(recorder, *level, &snapshot);
+        if (!recorder.GetPlayer()->HasShield()) return fail(check, "the shield monitor was never broken");
+        if (!recorder.getRecording()->save(path)) return fail(check, "could not save " + path);
+
+        Replay replay;
+        const bool loaded = replay.load(path);
+        std::error_code error;
+        std::filesystem::remove(path, error);
+        std::filesystem::remove(Replay::sidecarPath(path), error);
+        if (!loaded) return fail(check, "could not load " + path);
+
+        const Replay& recorded = *recorder.getRecording();
+        if (replay.seed != recorded.seed || replay.frames.size() != recorded.frames.size() ||
+            replay.hashes.size() != recorded.hashes.size()) {
+            return fail(check, "the saved run came back different");
+        }
+
+        GameEngine verifier(level);
+        if (const auto divergence = verifier.playReplay(replay)) {
+            return fail(check, "diverged at step " + std::to_string(divergence->frame) + " in " +
+                               hashPartName(divergence->part));
+        }
+        if (!verifier.GetPlayer()->HasShield()) return fail(check, "the verified run kept the monitor");
+        return true;
+    }
+}
+
+int main() {
+    AssetPack pack;
+    int failed = 0;
+    {
+        const auto level = GameEngine::loadHeadlessLevel(pack);
+        if (!windowedMatchesHeadless(level)) ++failed;
+        if (!recordingVerifies(level)) ++failed;
+    }
+    AssetPack::unmount(&pack);
+    if (failed == 0) std::cerr << "all checks passed" << std::endl;
+    return failed;
+}
@@ -0,0 +1,137 @@
+// Builds the single-file asset pack the game maps at start, or lists and checks one.
+//
+//   pack_assets <assets dir> <out.pak>
+//   pack_assets --list <pack.pak>
+#include "../include/AssetPack.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    struct Source {
+        std::string path;           // as the game asks for it, e.g. "assets/Map.csv"
+        std::vector<uint8_t> bytes;
+        AssetPack::Entry entry{};
+    };
+
+    bool readFile(const fs::path& path, std::vector<uint8_t>& bytes) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) return false;
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    size_t align(size_t value) {
+        return (value + AssetPack::DATA_ALIGNMENT - 1) / AssetPack::DATA_ALIGNMENT * AssetPack::DATA_ALIGNMENT;
+    }
+
+    // Generated caches live next to the assets but never ship
+    bool skip(const fs::path& path) {
+        const std::string name = path.filename().string();
+        return name.empty() || name[0] == '.' || path.extension() == ".pcmcache" ||
+               path.extension() == ".tmp" || path.extension() == ".pak";
+    }
+
+    int build(const fs::path& root, const fs::path& output) {
+        std::vector<Source> sources;
+        for (const auto& item : fs::recursive_directory_iterator(root)) {
+            if (!item.is_regular_file() || skip(item.path())) continue;
+
+            Source source;
+            source.path = (root.filename() / fs::relative(item.path(), root)).generic_string();
+            if (!readFile(item.path(), source.bytes)) {
+                std::cerr << "fail " << item.path() << std::endl;
+                return 1;
+            }
+            source.entry.pathHash = AssetPack::hashPath(source.path);
+            source.entry.size = source.bytes.size();
+            source.entry.checksum = AssetPack::hash(source.bytes.data(), source.bytes.size());
+            source.entry.type = AssetPack::typeOf(source.path);
+            sources.push_back(std::move(source));
+        }
+
+        std::sort(sources.begin(), sources.end(),
+                  [](const Source& a, const Source& b) { return a.entry.pathHash < b.entry.pathHash; });
+        for (size_t i = 1; i < sources.size(); ++i) {
+            if (sources[i].entry.pathHash == sources[i - 1].entry.pathHash) {
+                std::cerr << "fail " << sources[i - 1].path << " and " << sources[i].path
+                          << " collide (paths are case-insensitive)" << std::endl;
+                return 1;
+            }
+        }
+
+        std::string names;
+        for (const auto& source : sources) {
+            names += source.path;
+            names += '\0';
+        }
+
+        const size_t namesStart = sizeof(AssetPack::Header) + sources.size() * sizeof(AssetPack::Entry);
+        size_t offset = align(namesStart + names.size());
+        for (auto& source : sources) {
+            source.entry.offset = offset;
+            offset = align(offset + source.bytes.size());
+        }
+
+        AssetPack::Header header{};
+        std::memcpy(header.magic, "SPAK", 4);
+        header.version = AssetPack::VERSION;
+        header.entryCount = static_cast<uint32_t>(sources.size());
+        header.namesSize = static_cast<uint32_t>(names.size());
+
+        std::vector<uint8_t> out(offset, 0);
+        std::memcpy(out.data(), &header, sizeof(header));
+        for (size_t i = 0; i < sources.size(); ++i) {
+            std::memcpy(out.data() + sizeof(header) + i * sizeof(AssetPack::Entry), &sources[i].entry, sizeof(AssetPack::Entry));
+            std::copy(sources[i].bytes.begin(), sources[i].bytes.end(), out.begin() + static_cast<std::ptrdiff_t>(sources[i].entry.offset));
+        }
+        std::copy(names.begin(), names.end(), out.begin() + static_cast<std::ptrdiff_t>(namesStart));
+
+        std::ofstream stream(output, std::ios::binary | std::ios::trunc);
+        if (!stream.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()))) {
+            std::cerr << "fail " << output << std::endl;
+            return 1;
+        }
+
+        std::cout << "packed " << sources.size() << " files, " << out.size() << " bytes into " << output.string() << std::endl;
+        return 0;
+    }
+
+    int list(const std::string& path) {
+        AssetPack pack;
+        if (!pack.open(path)) {
+            std::cerr << "fail " << path << std::endl;
+            return 1;
+        }
+
+        int bad = 0;
+        const auto& entries = pack.getEntries();
+        const auto& names = pack.getNames();
+        for (size_t i = 0; i < entries.size(); ++i) {
+            const auto& entry = entries[i];
+            const bool ok = pack.verify(entry);
+            bad += ok ? 0 : 1;
+            std::cout << (names.empty() ? "?" : names[i]) << "  " << entry.size << " bytes  type "
+                      << static_cast<uint32_t>(entry.type) << (ok ? "  ok" : "  CHECKSUM MISMATCH") << std::endl;
+        }
+        return bad == 0 ? 0 : 1;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc == 3 && std::strcmp(argv[1], "--list") == 0) {
+        return list(argv[2]);
+    }
+    if (argc == 3) {
+        return build(argv[1], argv[2]);
+    }
+
+    std::cerr << "usage: pack_assets <assets dir> <out.pak> | --list <pack.pak>" << std::endl;
+    return 2;
+}
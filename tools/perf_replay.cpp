@@ -0,0 +1,639 @@
+// Plays the recorded perf runs on a headless engine, times every step and every
+// frame recording, and checks the results against the baseline.
+//
+//   perf_replay [--replays <dir>] [--baseline <file>] [--out <file>] [--update-baseline]
+//   perf_replay --generate [--replays <dir>]
+//
+// Runs are recordings, one per entry in RUNS. A run that has no recording yet
+// is recorded first from the scripted inputs below, with a fixed seed and time
+// step, so its hashes come from this build; --generate records all of them
+// again, and `main --record <dir>/<run>.rpl` replaces one with a played run.
+// Results go out as JSON (stdout unless --out is given). With a baseline, any
+// percentile or allocation count past its tolerance is listed and the exit
+// code is 1; without one there is nothing to gate on and it says so.
+// --update-baseline writes the results as the new baseline instead.
+// Headless engines have no textures, so "render" is the CPU side only: culling
+// and filling the frame snapshot, as the simulation thread does every frame.
+// Allocations are whatever AllocationCounter saw during each phase
+#include "../include/GameEngine.h"
+#include "../include/AllocationCounter.h"
+#include "../include/Player.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef PERF_DIR
+#define PERF_DIR "./perf"
+#endif
+
+namespace {
+    // The fixed set of runs, each aimed at a different hot path
+    const char* const RUNS[] = {
+            "full_level",           // start to finish: physics and map collision throughout
+            "death_heavy",          // repeated deaths, respawns and restarts
+            "spring_heavy",         // springs and long airborne stretches
+            "ring_scatter_heavy"    // repeated hits with many rings scattered
+    };
+
+    constexpr int REPEATS = 3;                  // each frame keeps its fastest of these
+    constexpr double TIME_TOLERANCE = 0.20;     // fraction over baseline allowed for percentiles
+    constexpr double TIME_SLACK_US = 2.0;       // absolute slack, so sub-microsecond noise never fails
+    constexpr double MAX_TOLERANCE = 1.0;       // max is one outlier; only doubling it counts
+    constexpr double ALLOCATION_TOLERANCE = 0.05;
+
+    struct Percentiles {
+        double p50{0.0};
+        double p95{0.0};
+        double p99{0.0};
+        double max{0.0};
+    };
+
+    struct RunResult {
+        std::string name;
+        size_t frames{0};
+        Percentiles update;
+        Percentiles render;
+        size_t updateAllocations{0};
+        size_t renderAllocations{0};
+    };
+
+    // Nearest rank on a sorted copy
+    Percentiles percentiles(std::vector<double> samples) {
+        Percentiles result;
+        if (samples.empty()) return result;
+        std::sort(samples.begin(), samples.end());
+        auto rank = [&samples](double fraction) {
+            const size_t index = static_cast<size_t>(fraction * static_cast<double>(samples.size() - 1) + 0.5);
+            return samples[std::min(index, samples.size() - 1)];
+        };
+        result.p50 = rank(0.50);
+        result.p95 = rank(0.95);
+        result.p99 = rank(0.99);
+        result.max = samples.back();
+        return result;
+    }
+
+    struct StepCost {
+        double stepUs{0.0};
+        double recordUs{0.0};
+        size_t stepAllocations{0};
+        size_t recordAllocations{0};
+    };
+
+    // Every run is stepped the same way, when it is recorded and when it is
+    // timed: the step, then its hash, then the frame recording if there is a
+    // snapshot to fill. The hash never sees what recording does
+    StateHash stepRun(GameEngine& engine, const Replay::Frame& frame, RenderSnapshot* snapshot, StepCost& cost) {
+        const size_t beforeStep = AllocationCounter::total();
+        sf::Clock clock;
+        engine.stepReplay(frame);
+        cost.stepUs = static_cast<double>(clock.getElapsedTime().asMicroseconds());
+        cost.stepAllocations = AllocationCounter::total() - beforeStep;
+
+        const StateHash hash = engine.hashState();
+        if (snapshot) {
+            const size_t beforeRecord = AllocationCounter::total();
+            clock.restart();
+            engine.recordFrame(*snapshot);
+            cost.recordUs = static_cast<double>(clock.getElapsedTime().asMicroseconds());
+            cost.recordAllocations = AllocationCounter::total() - beforeRecord;
+        }
+        return hash;
+    }
+
+    // Plays one recording REPEATS times on fresh engines. Allocations are counted
+    // on the first pass; they do not change between passes
+    bool play(const std::shared_ptr<const LevelData>& level, const Replay& replay, RunResult& result) {
+        const size_t frames = replay.frames.size();
+        std::vector<double> updateUs(frames, 1e30);
+        std::vector<double> renderUs(frames, 1e30);
+        RenderSnapshot snapshot;
+
+        for (int pass = 0; pass < REPEATS; ++pass) {
+            GameEngine engine(level);
+            engine.setSeed(replay.seed);
+
+            for (size_t i = 0; i < frames; ++i) {
+                StepCost cost;
+                const StateHash hash = stepRun(engine, replay.frames[i], &snapshot, cost);
+
+                updateUs[i] = std::min(updateUs[i], cost.stepUs);
+                renderUs[i] = std::min(renderUs[i], cost.recordUs);
+                if (pass == 0) {
+                    result.updateAllocations += cost.stepAllocations;
+                    result.renderAllocations += cost.recordAllocations;
+                }
+
+                // A timing run on a diverged replay measures some other run
+                if (pass == 0 && i < replay.hashes.size() && hash.combined() != replay.hashes[i].combined()) {
+                    std::cerr << "fail " << result.name << " diverged at frame " << i << std::endl;
+                    return false;
+                }
+            }
+        }
+
+        result.frames = frames;
+        result.update = percentiles(std::move(updateUs));
+        result.render = percentiles(std::move(renderUs));
+        return true;
+    }
+
+    // The scripts drive a headless engine one step at a time. Each looks at the
+    // player and fills in the next step's frame, or returns false once its run
+    // is over. They steer by position rather than by a fixed list of presses,
+    // so a run keeps doing what its name says when the level changes; what is
+    // replayed afterwards is the recording, not the script
+    using Script = std::function<bool(GameEngine& engine, size_t step, Replay::Frame& frame)>;
+
+    constexpr uint64_t SCRIPT_SEED = 454;
+    constexpr float SCRIPT_STEP = 1.0f / 60.0f;
+    constexpr size_t SCRIPT_MAX_STEPS = 4000;
+    constexpr float REACH = 3.0f;               // god mode moves 5px a step
+    constexpr float CRUISE_Y = 399.0f;          // above the badniks walking the ground
+    constexpr float SPRING_HOVER = 50.0f;       // drop height above a spring that lands on it slowly
+
+    Replay::Frame scriptFrame(const PlayerInput& input, bool godMode, bool reset = false) {
+        return Replay::Frame{input, SCRIPT_STEP, reset, godMode};
+    }
+
+    // One god mode step towards target; true once the player is there
+    bool flyTo(GameEngine& engine, const sf::Vector2f& target, Replay::Frame& frame) {
+        const sf::Vector2f pos = engine.GetPlayer()->getPosition();
+        PlayerInput input;
+        input.left = pos.x > target.x + REACH;
+        input.right = pos.x < target.x - REACH;
+        input.up = pos.y > target.y + REACH;
+        input.down = pos.y < target.y - REACH;
+        frame = scriptFrame(input, true);
+        return !input.left && !input.right && !input.up && !input.down;
+    }
+
+    // Follows the waypoints in order; restart() goes round again
+    class Route {
+    public:
+        explicit Route(std::vector<sf::Vector2f> waypoints) : waypoints(std::move(waypoints)) {}
+
+        bool done() const { return next >= waypoints.size(); }
+        void restart() { next = 0; }
+
+        void fly(GameEngine& engine, Replay::Frame& frame) {
+            if (!done() && flyTo(engine, waypoints[next], frame)) ++next;
+        }
+
+    private:
+        std::vector<sf::Vector2f> waypoints;
+        size_t next{0};
+    };
+
+    // Up to cruising height, across and down onto target, clear of the badniks
+    // that walk the ground in between
+    void overhead(std::vector<sf::Vector2f>& waypoints, const sf::Vector2f& from, const sf::Vector2f& target) {
+        waypoints.push_back({from.x, CRUISE_Y});
+        waypoints.push_back({target.x, CRUISE_Y});
+        waypoints.push_back(target);
+    }
+
+    // Start to finish at cruising height, dropping through the ring groups on
+    // the way, until the level is completed
+    Script fullLevel(const LevelData& level) {
+        std::vector<sf::Vector2f> waypoints{{level.playerStart.x, CRUISE_Y}};
+        for (const auto& group : level.ringGroups) {
+            const float endX = group.startX + static_cast<float>(group.count - 1) * RingField::GROUP_SPACING;
+            waypoints.push_back({group.startX, CRUISE_Y});
+            waypoints.push_back({group.startX, group.startY});
+            waypoints.push_back({endX, group.startY});
+            waypoints.push_back({endX, CRUISE_Y});
+        }
+        waypoints.push_back({GameEngine::LEVEL_END_X + 50.0f, CRUISE_Y});
+
+        auto route = std::make_shared<Route>(std::move(waypoints));
+        auto finished = std::make_shared<size_t>(0);
+        return [route, finished](GameEngine& engine, size_t, Replay::Frame& frame) {
+            if (engine.GetCurrentState() != GameState::PLAYING) {
+                frame = scriptFrame(PlayerInput{}, true);
+                return ++*finished <= 60;
+            }
+            route->fly(engine, frame);
+            if (route->done()) flyTo(engine, {GameEngine::LEVEL_END_X + 50.0f, CRUISE_Y}, frame);
+            return true;
+        };
+    }
+
+    // Without god mode: run and jump until every life is gone, restart, and
+    // again. Every other game flies into the first motobug instead, so badnik
+    // deaths are in the mix with falls
+    Script deathHeavy(const LevelData& level) {
+        const sf::Vector2f motobug = level.motobugs.front();
+        auto games = std::make_shared<int>(0);
+        auto over = std::make_shared<int>(0);
+        return [motobug, games, over](GameEngine& engine, size_t step, Replay::Frame& frame) {
+            if (step >= 2400) return false;
+            if (engine.GetCurrentState() == GameState::GAME_OVER) {
+                const bool reset = ++*over > 30;
+                if (reset) {
+                    *over = 0;
+                    ++*games;
+                }
+                frame = scriptFrame(PlayerInput{}, false, reset);
+                return true;
+            }
+            if (*games % 2 == 1) {
+                flyTo(engine, motobug, frame);
+                return true;
+            }
+            PlayerInput input;
+            input.right = true;
+            input.jump = step % 40 < 10;
+            frame = scriptFrame(input, false);
+            return true;
+        };
+    }
+
+    // Bounces on each spring in turn with jump held. The only floor is the
+    // spring, so every bounce is a long airborne arc; a step of god mode at
+    // hover height on the way down stops the player, so the next landing is slow
+    Script springHeavy(const LevelData& level) {
+        constexpr int BOUNCES_PER_SPRING = 8;
+        const std::vector<sf::Vector2f> springs = level.springs;
+        struct State {
+            std::optional<Route> travel;
+            size_t spring{0};
+            int bounces{0};
+            int lives{0};
+            bool bouncing{false};
+            bool rising{false};
+            bool stopped{false};
+        };
+        auto state = std::make_shared<State>();
+        return [springs, state](GameEngine& engine, size_t step, Replay::Frame& frame) {
+            if (step >= 3200) return false;
+            const Player& player = *engine.GetPlayer();
+            const sf::Vector2f spring = springs[state->spring % springs.size()];
+            const sf::Vector2f hover(spring.x + 1.0f, spring.y - SPRING_HOVER);
+
+            // Knocked off the spring or respawned: make the trip again
+            const bool knockedOff = state->bouncing && std::abs(player.getPosition().x - hover.x) > 40.0f;
+            if (engine.getLives() != state->lives || knockedOff) {
+                state->lives = engine.getLives();
+                state->bouncing = false;
+                state->travel.reset();
+            }
+            if (!state->bouncing) {
+                if (!state->travel) {
+                    std::vector<sf::Vector2f> waypoints;
+                    overhead(waypoints, player.getPosition(), hover);
+                    state->travel.emplace(std::move(waypoints));
+                }
+                state->travel->fly(engine, frame);
+                state->bouncing = state->travel->done();
+                if (state->bouncing) state->travel.reset();
+                return true;
+            }
+
+            const float velocityY = player.velocity.y;
+            if (velocityY < -15.0f && !state->rising) {
+                state->rising = true;
+                state->stopped = false;
+                if (++state->bounces >= BOUNCES_PER_SPRING) {
+                    state->bounces = 0;
+                    ++state->spring;
+                }
+            }
+            if (velocityY > 0.0f) state->rising = false;
+
+            PlayerInput input;
+            input.jump = true;
+            const bool stop = !state->stopped && velocityY > 0.0f && player.getPosition().y >= hover.y;
+            state->stopped = state->stopped || stop;
+            frame = scriptFrame(stop ? PlayerInput{} : input, stop);
+            return true;
+        };
+    }
+
+    // Collects the rings near the start and carries them on towards a crabmeat
+    // until the first badnik in the way knocks them loose, then waits above
+    // the scatter while they fly and fade and restarts to do it again
+    Script ringScatterHeavy(const LevelData& level) {
+        std::vector<sf::Vector2f> waypoints;
+        sf::Vector2f at = level.playerStart;
+        for (const auto& group : level.ringGroups) {
+            if (group.startX > 1500.0f) continue;
+            overhead(waypoints, at, {group.startX, group.startY});
+            at = {group.startX + static_cast<float>(group.count - 1) * RingField::GROUP_SPACING, group.startY};
+            waypoints.push_back(at);
+        }
+        overhead(waypoints, at, level.crabmeats.front());
+
+        struct State {
+            Route route;
+            int waited{0};
+            int lives{0};
+            bool hit{false};
+        };
+        auto state = std::make_shared<State>(State{Route(std::move(waypoints))});
+        return [state](GameEngine& engine, size_t step, Replay::Frame& frame) {
+            if (step >= 2600) return false;
+            const bool died = engine.getLives() < state->lives;
+            state->lives = engine.getLives();
+            state->hit = state->hit || engine.GetPlayer()->IsHurt();
+            if (!died && !state->hit && !state->route.done()) {
+                state->route.fly(engine, frame);
+                return true;
+            }
+            const bool reset = died || ++state->waited > 180;
+            if (reset) {
+                state->waited = 0;
+                state->hit = false;
+                state->route.restart();
+                frame = scriptFrame(PlayerInput{}, true, true);
+            } else {
+                flyTo(engine, {engine.GetPlayer()->getPosition().x, CRUISE_Y}, frame);
+            }
+            return true;
+        };
+    }
+
+    Script scriptFor(const std::string& name, const LevelData& level) {
+        if (name == "full_level") return fullLevel(level);
+        if (name == "death_heavy") return deathHeavy(level);
+        if (name == "spring_heavy") return springHeavy(level);
+        return ringScatterHeavy(level);
+    }
+
+    // Records one run from its script: every frame and the state hash after it
+    bool generate(const std::shared_ptr<const LevelData>& level, const std::string& name, const std::string& path) {
+        GameEngine engine(level);
+        engine.setSeed(SCRIPT_SEED);
+        Replay replay;
+        replay.seed = SCRIPT_SEED;
+
+        const Script script = scriptFor(name, *level);
+        Replay::Frame frame;
+        StepCost cost;
+        for (size_t step = 0; step < SCRIPT_MAX_STEPS && script(engine, step, frame); ++step) {
+            replay.hashes.push_back(stepRun(engine, frame, nullptr, cost));
+            replay.frames.push_back(frame);
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+        if (!replay.save(path)) return false;
+        std::cerr << "recorded " << name << ": " << replay.frames.size() << " frames" << std::endl;
+        return true;
+    }
+
+    void writePercentiles(std::ostream& out, const char* key, const Percentiles& value) {
+        out << "      \"" << key << "\": {\"p50\": " << value.p50 << ", \"p95\": " << value.p95
+            << ", \"p99\": " << value.p99 << ", \"max\": " << value.max << "},\n";
+    }
+
+    std::string toJson(const std::vector<RunResult>& results) {
+        std::ostringstream out;
+        out << "{\n  \"runs\": {\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto& run = results[i];
+            out << "    \"" << run.name << "\": {\n";
+            out << "      \"frames\": " << run.frames << ",\n";
+            writePercentiles(out, "update_us", run.update);
+            writePercentiles(out, "render_us", run.render);
+            out << "      \"allocations\": {\"update\": " << run.updateAllocations
+                << ", \"render\": " << run.renderAllocations << "}\n";
+            out << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  }\n}\n";
+        return out.str();
+    }
+
+    // Just enough JSON for our own output: nested objects of numbers, flattened
+    // to dotted keys such as "runs.full_level.update_us.p99"
+    class FlatJson {
+    public:
+        explicit FlatJson(const std::string& text) : text(text) {}
+
+        bool parse(std::map<std::string, double>& values) {
+            skipSpace();
+            return parseObject("", values) && (skipSpace(), cursor == text.size());
+        }
+
+    private:
+        bool parseObject(const std::string& prefix, std::map<std::string, double>& values) {
+            if (!take('{')) return false;
+            skipSpace();
+            if (take('}')) return true;
+            for (;;) {
+                std::string key;
+                if (!parseString(key)) return false;
+                skipSpace();
+                if (!take(':')) return false;
+                skipSpace();
+
+                const std::string path = prefix.empty() ? key : prefix + "." + key;
+                if (cursor < text.size() && text[cursor] == '{') {
+                    if (!parseObject(path, values)) return false;
+                } else {
+                    const char* begin = text.c_str() + cursor;
+                    char* end = nullptr;
+                    const double number = std::strtod(begin, &end);
+                    if (end == begin) return false;
+                    cursor += static_cast<size_t>(end - begin);
+                    values[path] = number;
+                }
+
+                skipSpace();
+                if (take('}')) return true;
+                if (!take(',')) return false;
+                skipSpace();
+            }
+        }
+
+        bool parseString(std::string& out) {
+            if (!take('"')) return false;
+            const size_t end = text.find('"', cursor);
+            if (end == std::string::npos) return false;
+            out = text.substr(cursor, end - cursor);
+            cursor = end + 1;
+            return true;
+        }
+
+        bool take(char expected) {
+            if (cursor < text.size() && text[cursor] == expected) {
+                ++cursor;
+                return true;
+            }
+            return false;
+        }
+
+        void skipSpace() {
+            while (cursor < text.size() && std::isspace(static_cast<unsigned char>(text[cursor]))) ++cursor;
+        }
+
+        const std::string& text;
+        size_t cursor{0};
+    };
+
+    bool readText(const std::string& path, std::string& text) {
+        std::ifstream in(path);
+        if (!in) return false;
+        std::ostringstream buffer;
+        buffer << in.rdbuf();
+        text = buffer.str();
+        return true;
+    }
+
+    bool writeText(const std::string& path, const std::string& text) {
+        std::error_code error;
+        const auto parent = std::filesystem::path(path).parent_path();
+        if (!parent.empty()) std::filesystem::create_directories(parent, error);
+
+        std::ofstream out(path, std::ios::trunc);
+        if (!(out << text)) {
+            std::cerr << "fail " << path << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    // Lists every value past its tolerance; returns how many there were
+    int compare(const std::map<std::string, double>& baseline, const std::map<std::string, double>& current) {
+        int regressions = 0;
+        for (const auto& [key, value] : current) {
+            const auto it = baseline.find(key);
+            if (it == baseline.end()) {
+                std::cerr << "no baseline for " << key << std::endl;
+                continue;
+            }
+
+            double limit = it->second;
+            if (key.find(".allocations.") != std::string::npos) {
+                limit = it->second * (1.0 + ALLOCATION_TOLERANCE);
+            } else if (key.find("_us.max") != std::string::npos) {
+                limit = it->second * (1.0 + MAX_TOLERANCE) + TIME_SLACK_US;
+            } else if (key.find("_us.") != std::string::npos) {
+                limit = it->second * (1.0 + TIME_TOLERANCE) + TIME_SLACK_US;
+            } else {
+                continue;   // frame counts only describe the run
+            }
+
+            if (value > limit) {
+                std::cerr << "regression " << key << ": " << value << " over baseline " << it->second
+                          << " (limit " << limit << ")" << std::endl;
+                ++regressions;
+            }
+        }
+        return regressions;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string replayDir = std::string(PERF_DIR) + "/replays";
+    std::string baselinePath = std::string(PERF_DIR) + "/baseline.json";
+    std::string outPath;
+    bool updateBaseline = false;
+    bool generateRuns = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--update-baseline") {
+            updateBaseline = true;
+        } else if (arg == "--generate") {
+            generateRuns = true;
+        } else if (arg == "--replays" && i + 1 < argc) {
+            replayDir = argv[++i];
+        } else if (arg == "--baseline" && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (arg == "--out" && i + 1 < argc) {
+            outPath = argv[++i];
+        } else {
+            std::cerr << "usage: perf_replay [--replays <dir>] [--baseline <file>] [--out <file>] [--update-baseline]\n"
+                      << "       perf_replay --generate [--replays <dir>]" << std::endl;
+            return 2;
+        }
+    }
+
+    if (generateRuns) {
+        AssetPack pack;
+        bool ok = true;
+        {
+            const auto level = GameEngine::loadHeadlessLevel(pack);
+            for (const char* run : RUNS) {
+                ok = generate(level, run, replayDir + "/" + run + ".rpl") && ok;
+            }
+        }
+        AssetPack::unmount(&pack);
+        return ok ? 0 : 1;
+    }
+
+    std::vector<RunResult> results;
+    AssetPack pack;
+    {
+        const auto level = GameEngine::loadHeadlessLevel(pack);
+
+        std::vector<Replay> replays(std::size(RUNS));
+        for (size_t i = 0; i < std::size(RUNS); ++i) {
+            const std::string path = replayDir + "/" + RUNS[i] + ".rpl";
+            if (!std::filesystem::exists(path)) {
+                std::cerr << "no recording at " << path << ", recording it" << std::endl;
+                if (!generate(level, RUNS[i], path)) return 1;
+            }
+            if (!replays[i].load(path)) return 1;
+        }
+
+        for (size_t i = 0; i < std::size(RUNS); ++i) {
+            RunResult result;
+            result.name = RUNS[i];
+            if (!play(level, replays[i], result)) return 1;
+            results.push_back(result);
+        }
+    }
+    AssetPack::unmount(&pack);
+
+    const std::string json = toJson(results);
+    if (outPath.empty()) {
+        std::cout << json;
+    } else if (!writeText(outPath, json)) {
+        return 1;
+    }
+
+    if (updateBaseline) {
+        if (!writeText(baselinePath, json)) return 1;
+        std::cerr << "baseline written to " << baselinePath << std::endl;
+        return 0;
+    }
+
+    if (!std::filesystem::exists(baselinePath)) {
+        std::cerr << "no baseline at " << baselinePath << ", nothing checked (write one with --update-baseline)"
+                  << std::endl;
+        return 0;
+    }
+    std::string baselineText;
+    if (!readText(baselinePath, baselineText)) {
+        std::cerr << "fail " << baselinePath << std::endl;
+        return 1;
+    }
+    std::map<std::string, double> baseline;
+    std::map<std::string, double> current;
+    if (!FlatJson(baselineText).parse(baseline) || !FlatJson(json).parse(current)) {
+        std::cerr << "fail " << baselinePath << std::endl;
+        return 1;
+    }
+
+    const int regressions = compare(baseline, current);
+    if (regressions > 0) {
+        std::cerr << regressions << " regression(s) against " << baselinePath << std::endl;
+        return 1;
+    }
+    std::cerr << "no regressions against " << baselinePath << std::endl;
+    return 0;
+}